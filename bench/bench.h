@@ -0,0 +1,41 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+namespace bench
+{
+	//Keeps the optimizer from dropping the benchmarked work
+	template <class T>
+	inline void do_not_optimize(T const& value)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(value) : "memory");
+#else
+		static volatile auto sink = value;
+		sink = value;
+#endif
+	}
+
+	//Best wall time of `repetitions` runs in seconds, the minimum is the least noisy estimator
+	template <class F>
+	double measure(F&& f, int repetitions = 15)
+	{
+		auto best = std::chrono::duration<double>::max();
+		for (int i = 0; i < repetitions; ++i)
+		{
+			auto start = std::chrono::steady_clock::now();
+			f();
+			best = std::min<std::chrono::duration<double>>(best, std::chrono::steady_clock::now() - start);
+		}
+		return best.count();
+	}
+
+	inline void report(const char* name, double seconds, double bytes, double items)
+	{
+		if (bytes > 0)
+			std::printf("%-40s %10.3f ms %10.2f GB/s %10.2f ns/item\n", name, seconds * 1e3, bytes / seconds / 1e9, seconds / items * 1e9);
+		else
+			std::printf("%-40s %10.3f ms %10.2f ns/item\n", name, seconds * 1e3, seconds / items * 1e9);
+	}
+}
@@ -0,0 +1,53 @@
+# Runs one compiler invocation of compile_time_bench and fails it when it exceeds the budget.
+# Called through RULE_LAUNCH_COMPILE as
+#   cmake -DBUDGET_SECONDS=<s> -DBUDGET_KIB=<KiB> -DGNU_TIME=<GNU time or empty> -P budget.cmake -- <compile command>
+
+set(command)
+set(in_command FALSE)
+math(EXPR last_argument "${CMAKE_ARGC} - 1")
+foreach(i RANGE ${last_argument})
+	if(in_command)
+		list(APPEND command "${CMAKE_ARGV${i}}")
+	elseif(CMAKE_ARGV${i} STREQUAL "--")
+		set(in_command TRUE)
+	endif()
+endforeach()
+if(NOT command)
+	message(FATAL_ERROR "budget.cmake: no compile command after --")
+endif()
+
+list(FIND command "-o" output_index)
+if(output_index GREATER_EQUAL 0)
+	math(EXPR output_index "${output_index} + 1")
+	list(GET command ${output_index} object)
+else()
+	string(JOIN " " object ${command})
+endif()
+
+string(TIMESTAMP start "%s")
+if(GNU_TIME)
+	set(report "${object}.budget")
+	execute_process(COMMAND ${GNU_TIME} -f "%M" -o ${report} ${command} RESULT_VARIABLE result)
+else()
+	execute_process(COMMAND ${command} RESULT_VARIABLE result)
+endif()
+string(TIMESTAMP stop "%s")
+math(EXPR seconds "${stop} - ${start}")
+
+if(NOT result EQUAL 0)
+	message(FATAL_ERROR "${object}: compilation failed")
+endif()
+
+set(summary "${object}\n  ${seconds} s")
+if(GNU_TIME)
+	file(STRINGS ${report} peak REGEX "^[0-9]+$")
+	string(APPEND summary ", ${peak} KiB peak memory")
+endif()
+message(STATUS "${summary}")
+
+if(seconds GREATER BUDGET_SECONDS)
+	message(FATAL_ERROR "${object}: ${seconds} s is over the budget of ${BUDGET_SECONDS} s")
+endif()
+if(GNU_TIME AND peak GREATER BUDGET_KIB)
+	message(FATAL_ERROR "${object}: ${peak} KiB is over the budget of ${BUDGET_KIB} KiB")
+endif()
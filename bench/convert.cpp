@@ -0,0 +1,42 @@
+#include "si_convert.h"
+#include "bench.h"
+
+#include <cstring>
+#include <vector>
+
+//Compares the bulk conversion kernels against memcpy over the same bytes, a conversion that is
+//memory bound should reach (close to) the memcpy bandwidth once the data no longer fits in cache
+int main()
+{
+	using si::details::simd::isa;
+	constexpr const char* isa_names[] = { "scalar", "sse2", "avx2", "avx512" };
+
+	for (std::size_t n : { std::size_t{ 1 } << 12, std::size_t{ 1 } << 18, std::size_t{ 1 } << 26 })
+	{
+		auto input = si::quantity_vector<si::kilo_meter<float>>(n, si::kilo_meter{ 1.5f });
+		auto output = si::quantity_vector<si::meter<float>>(n);
+		const double bytes = 2.0 * n * sizeof(float);
+		const int repetitions = n > (1 << 20) ? 10 : 200;
+
+		std::printf("%zu values (%zu KiB per buffer)\n", n, n * sizeof(float) / 1024);
+
+		auto seconds = bench::measure([&] { std::memcpy(output.data(), input.data(), n * sizeof(float)); bench::do_not_optimize(output.data()); }, repetitions);
+		bench::report("  memcpy", seconds, bytes, static_cast<double>(n));
+
+		for (auto target : { isa::scalar, isa::sse2, isa::avx2, isa::avx512 })
+		{
+			if (target > si::details::simd::active_isa())
+				continue;
+			seconds = bench::measure([&] { si::details::simd::scale(input.data(), output.data(), n, 1000.0f, target); bench::do_not_optimize(output.data()); }, repetitions);
+			char name[64];
+			std::snprintf(name, sizeof(name), "  convert kilo_meter -> meter (%s)", isa_names[static_cast<int>(target)]);
+			bench::report(name, seconds, bytes, static_cast<double>(n));
+		}
+
+		seconds = bench::measure([&] { si::convert(input.span(), output.span()); bench::do_not_optimize(output.data()); }, repetitions);
+		bench::report("  si::convert (dispatched)", seconds, bytes, static_cast<double>(n));
+
+		seconds = bench::measure([&] { si::convert_in_place<si::kilo_meter<float>>(si::convert_in_place<si::meter<float>>(input.span())); bench::do_not_optimize(input.data()); }, repetitions);
+		bench::report("  si::convert_in_place (there and back)", seconds, 2.0 * bytes, 2.0 * n);
+	}
+}
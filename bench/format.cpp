@@ -0,0 +1,48 @@
+#include "si_format.h"
+#include "bench.h"
+
+#include <array>
+#include <iterator>
+#include <vector>
+
+//Formatting a quantity should only cost the value plus copying a suffix that is known at compile time
+int main()
+{
+	constexpr std::size_t n = 1 << 20;
+
+	auto values = std::vector<float>(n);
+	for (std::size_t i = 0; i < n; ++i)
+		values[i] = static_cast<float>(i) * 0.37f;
+
+	auto buffer = std::array<char, 64>{};
+
+	auto seconds = bench::measure([&] {
+		for (auto v : values)
+			bench::do_not_optimize(std::format_to(buffer.data(), "{}", v));
+	}, 5);
+	bench::report("std::format_to float", seconds, 0, n);
+
+	seconds = bench::measure([&] {
+		for (auto v : values)
+			bench::do_not_optimize(std::format_to(buffer.data(), "{}", si::newton{ v }));
+	}, 5);
+	bench::report("std::format_to si::newton<float>", seconds, 0, n);
+
+	seconds = bench::measure([&] {
+		for (auto v : values)
+			bench::do_not_optimize(std::to_chars(buffer.data(), buffer.data() + buffer.size(), v));
+	}, 5);
+	bench::report("std::to_chars float", seconds, 0, n);
+
+	seconds = bench::measure([&] {
+		for (auto v : values)
+			bench::do_not_optimize(si::to_chars(buffer.data(), buffer.data() + buffer.size(), si::newton{ v }));
+	}, 5);
+	bench::report("si::to_chars si::newton<float>", seconds, 0, n);
+
+	seconds = bench::measure([&] {
+		for (auto v : values)
+			bench::do_not_optimize(si::format_to_n(buffer.data(), buffer.size(), si::newton{ v }));
+	}, 5);
+	bench::report("si::format_to_n si::newton<float>", seconds, 0, n);
+}
@@ -0,0 +1,49 @@
+#include "si.h"
+#include "si_format.h"
+#include "bench.h"
+
+#include <array>
+#include <vector>
+
+//Unit typed kernels next to the same kernels on raw floats, every pair should take the same time.
+//Built twice, as overhead_bench_O2 and overhead_bench_O3.
+int main()
+{
+	constexpr std::size_t n = 1 << 20;
+	constexpr int repetitions = 50;
+
+	auto a = std::vector<float>(n, 1.5f);
+	auto b = std::vector<float>(n, 2.5f);
+	auto out = std::vector<float>(n);
+
+	auto meters = std::vector<si::meter<float>>(n, si::meter{ 1.5f });
+	auto other_meters = std::vector<si::meter<float>>(n, si::meter{ 2.5f });
+	auto kilo_meters = std::vector<si::kilo_meter<float>>(n, si::kilo_meter{ 2.5f });
+	auto seconds = std::vector<si::second<float>>(n, si::second{ 2.5f });
+	auto meters_out = std::vector<si::meter<float>>(n);
+	auto acceleration_out = std::vector<si::meters_per_second_squared<float>>(n);
+
+	const double bytes = 3.0 * n * sizeof(float);
+
+	auto time = bench::measure([&] { for (std::size_t i = 0; i < n; ++i) out[i] = a[i] + b[i]; bench::do_not_optimize(out.data()); }, repetitions);
+	bench::report("raw add", time, bytes, n);
+	time = bench::measure([&] { for (std::size_t i = 0; i < n; ++i) meters_out[i] = meters[i] + other_meters[i]; bench::do_not_optimize(meters_out.data()); }, repetitions);
+	bench::report("si::meter add", time, bytes, n);
+
+	time = bench::measure([&] { for (std::size_t i = 0; i < n; ++i) out[i] = a[i] + b[i] * 1000.0f; bench::do_not_optimize(out.data()); }, repetitions);
+	bench::report("raw add with scale", time, bytes, n);
+	time = bench::measure([&] { for (std::size_t i = 0; i < n; ++i) meters_out[i] = meters[i] + kilo_meters[i]; bench::do_not_optimize(meters_out.data()); }, repetitions);
+	bench::report("si::meter + si::kilo_meter", time, bytes, n);
+
+	time = bench::measure([&] { for (std::size_t i = 0; i < n; ++i) out[i] = a[i] / b[i] / b[i]; bench::do_not_optimize(out.data()); }, repetitions);
+	bench::report("raw a / b / b", time, bytes, n);
+	time = bench::measure([&] { for (std::size_t i = 0; i < n; ++i) acceleration_out[i] = si::infer_cast(meters[i] / seconds[i] / seconds[i]); bench::do_not_optimize(acceleration_out.data()); }, repetitions);
+	bench::report("infer_cast(m / s / s)", time, bytes, n);
+
+	auto buffer = std::array<char, 64>{};
+	constexpr std::size_t format_count = 1 << 16;
+	time = bench::measure([&] { for (std::size_t i = 0; i < format_count; ++i) bench::do_not_optimize(std::format_to(buffer.data(), "{}", a[i])); }, 5);
+	bench::report("std::format_to float", time, 0, format_count);
+	time = bench::measure([&] { for (std::size_t i = 0; i < format_count; ++i) bench::do_not_optimize(std::format_to(buffer.data(), "{}", meters[i])); }, 5);
+	bench::report("std::format_to si::meter<float>", time, 0, format_count);
+}
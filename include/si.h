@@ -1,18 +1,160 @@
 #pragma once
 #include <array>
+#include <compare>
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <numeric>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#ifdef SI_PROFILE_CONVERSIONS
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#endif
 
 namespace si
 {
 
 	namespace details
 	{
-		using exponent_array = std::array<int, 7>;
+		//Exponent of one base unit as a reduced fraction, so roots of a unit keep exact exponents.
+		//Converts from int, exponent_array{ 1, 0, 0, 0, 0, 0, 0 } still reads as before.
+		struct rational
+		{
+			int num = 0;
+			int den = 1;
+
+			constexpr rational() = default;
+
+			constexpr rational(int n, int d = 1) : num(n), den(d)
+			{
+				if (den < 0) {
+					num = -num;
+					den = -den;
+				}
+				const auto divisor = std::gcd(num, den);
+				num /= divisor;
+				den /= divisor;
+			}
+
+			[[nodiscard]] constexpr bool is_integer() const
+			{
+				return den == 1;
+			}
+
+			friend constexpr rational operator+(rational a, rational b)
+			{
+				return rational{ a.num * b.den + b.num * a.den, a.den * b.den };
+			}
+
+			friend constexpr rational operator-(rational a, rational b)
+			{
+				return rational{ a.num * b.den - b.num * a.den, a.den * b.den };
+			}
+
+			friend constexpr rational operator*(rational a, rational b)
+			{
+				return rational{ a.num * b.num, a.den * b.den };
+			}
+
+			friend constexpr rational operator/(rational a, rational b)
+			{
+				return rational{ a.num * b.den, a.den * b.num };
+			}
+
+			constexpr rational operator-() const
+			{
+				return rational{ -num, den };
+			}
+
+			constexpr rational& operator+=(rational other)
+			{
+				return *this = *this + other;
+			}
+
+			friend constexpr bool operator==(rational a, rational b) = default;
+
+			friend constexpr std::strong_ordering operator<=>(rational a, rational b)
+			{
+				return a.num * b.den <=> b.num * a.den;
+			}
+		};
+
+		using exponent_array = std::array<rational, 7>;
+
+		//Exact scale factor num / den * 10^exp10 * pi^pi.
+		//Always kept in one canonical form so equal factors compare equal as template arguments.
+		struct ratio
+		{
+			std::intmax_t num = 1;
+			std::intmax_t den = 1;
+			int exp10 = 0;
+			int pi = 0;
+
+			constexpr ratio() = default;
+
+			constexpr ratio(std::intmax_t n, std::intmax_t d = 1, int e = 0, int p = 0) : num(n), den(d), exp10(e), pi(p)
+			{
+				if (den < 0) {
+					num = -num;
+					den = -den;
+				}
+				const auto divisor = std::gcd(num, den);
+				num /= divisor;
+				den /= divisor;
+
+				//Powers of 2 and 5 move from the denominator into the numerator, powers of 10 into exp10
+				while (den % 2 == 0) {
+					den /= 2;
+					num *= 5;
+					--exp10;
+				}
+				while (den % 5 == 0) {
+					den /= 5;
+					num *= 2;
+					--exp10;
+				}
+				while (num != 0 && num % 10 == 0) {
+					num /= 10;
+					++exp10;
+				}
+			}
+
+			friend constexpr ratio operator*(ratio a, ratio b)
+			{
+				return ratio{ a.num * b.num, a.den * b.den, a.exp10 + b.exp10, a.pi + b.pi };
+			}
+
+			friend constexpr ratio operator/(ratio a, ratio b)
+			{
+				return ratio{ a.num * b.den, a.den * b.num, a.exp10 - b.exp10, a.pi - b.pi };
+			}
+
+			friend constexpr bool operator==(ratio a, ratio b) = default;
+
+			template <class T>
+			[[nodiscard]] constexpr T as() const
+			{
+				long double value = static_cast<long double>(num);
+				long double scale = 1.0L;
+				for (int i = 0; i < (exp10 < 0 ? -exp10 : exp10); ++i)
+					scale *= 10.0L;
+				value = exp10 < 0 ? value / (scale * den) : value * scale / den;
+				for (int i = 0; i < (pi < 0 ? -pi : pi); ++i)
+					value = pi < 0 ? value / std::numbers::pi_v<long double> : value * std::numbers::pi_v<long double>;
+				return static_cast<T>(value);
+			}
+		};
 
 		struct unit_descriptor
 		{
 			exponent_array exponent;
-			float factor;
+			ratio factor;
 		};
 
 		template <class T, class... TRest>
@@ -45,6 +187,63 @@ namespace si
 			return from.factor / to.factor;
 		}
 
+		//A factor without pi as multiplier / divisor, both integers
+		struct integer_ratio
+		{
+			std::intmax_t multiplier = 1;
+			std::intmax_t divisor = 1;
+		};
+
+		constexpr integer_ratio integer_factor(ratio factor)
+		{
+			auto result = integer_ratio{ factor.num, factor.den };
+			for (int i = 0; i < factor.exp10; ++i)
+				result.multiplier *= 10;
+			for (int i = 0; i < -factor.exp10; ++i)
+				result.divisor *= 10;
+			return result;
+		}
+
+		//Exact integer rescaling: a multiply, a divide, or a multiply and a divide in intmax_t.
+		//Results round toward zero like integer division, results that do not fit wrap like raw integer arithmetic.
+		template <ratio factor, std::integral T>
+		[[nodiscard]] constexpr T integer_rescale(T value)
+		{
+			static_assert(factor.pi == 0, "Factors of pi cannot be applied exactly to integers");
+			constexpr auto r = integer_factor(factor);
+			using wide = std::conditional_t<std::is_signed_v<T>, std::intmax_t, std::uintmax_t>;
+
+			if constexpr (r.divisor == 1)
+				return static_cast<T>(static_cast<wide>(value) * static_cast<wide>(r.multiplier));
+			else if constexpr (r.multiplier == 1 && std::cmp_greater(r.divisor, std::numeric_limits<T>::max()))
+				return T{};
+			else if constexpr (r.multiplier == 1)
+				return static_cast<T>(value / static_cast<T>(r.divisor));
+			else
+				return static_cast<T>(static_cast<wide>(value) * static_cast<wide>(r.multiplier) / static_cast<wide>(r.divisor));
+		}
+
+		//Value types with their own exact scaling, see si_integer.h
+		template <class T, ratio factor>
+		concept self_scaling_c = requires(T value) { { value.template scaled<factor>() } -> std::same_as<T>; };
+
+		//Applies a compile time factor with a single multiply, or none when the factor is 1.
+		//Integers stay in integer arithmetic.
+		template <ratio factor, class T>
+		[[nodiscard]] constexpr T rescale(T value)
+		{
+			if constexpr (factor == ratio{})
+				return value;
+			else if constexpr (std::is_floating_point_v<T>)
+				return value * factor.template as<T>();
+			else if constexpr (std::is_integral_v<T>)
+				return integer_rescale<factor>(value);
+			else if constexpr (self_scaling_c<T, factor>)
+				return value.template scaled<factor>();
+			else
+				return factor.template as<float>() * value;
+		}
+
 		consteval auto operator*(exponent_array a, exponent_array b)
 		{
 			return add_exponents(a, b);
@@ -55,14 +254,14 @@ namespace si
 			return subtract_exponents(a, b);
 		}
 
-		consteval auto operator^(exponent_array a, int exponent)
+		consteval auto operator^(exponent_array a, rational exponent)
 		{
 			for (size_t i = 0; i < a.size(); ++i)
 				a[i] = a[i] * exponent;
 			return a;
 		}
 
-		consteval auto operator*(unit_descriptor a, float factor)
+		consteval auto operator*(unit_descriptor a, ratio factor)
 		{
 			return unit_descriptor{ .exponent = a.exponent, .factor = a.factor * factor };
 		}
@@ -75,42 +274,196 @@ namespace si
 		constexpr auto candela_expo = exponent_array{ 0, 0, 0, 0, 0, 1, 0 };
 		constexpr auto gram_expo = exponent_array{ 0, 0, 0, 0, 0, 0, 1 };
 
-		constexpr auto meter_desc = unit_descriptor{ .exponent = meter_expo, .factor = 1.0f };
-		constexpr auto second_desc = unit_descriptor{ .exponent = second_expo, .factor = 1.0f };
-		constexpr auto mol_desc = unit_descriptor{ .exponent = mol_expo, .factor = 1.0f };
-		constexpr auto ampere_desc = unit_descriptor{ .exponent = ampere_expo, .factor = 1.0f };
-		constexpr auto kelvin_desc = unit_descriptor{ .exponent = kelvin_expo, .factor = 1.0f };
-		constexpr auto candela_desc = unit_descriptor{ .exponent = candela_expo, .factor = 1.0f };
-		constexpr auto gram_desc = unit_descriptor{ .exponent = gram_expo, .factor = 0.001f };
-
-		constexpr auto squared_meter_desc = unit_descriptor{ .exponent = meter_expo ^ 2, .factor = 1.0f };
-		constexpr auto cubic_meter_desc = unit_descriptor{ .exponent = meter_expo ^ 3, .factor = 1.0f };
-
-		constexpr auto velocity_desc = unit_descriptor{ .exponent = meter_expo / second_expo, .factor = 1.0f };
-		constexpr auto acceleration_desc = unit_descriptor{ .exponent = velocity_desc.exponent / second_expo, .factor = 1.0f };
-
-		constexpr auto hertz_desc = unit_descriptor{ .exponent = second_expo ^ -1, .factor = 1.0f };
-		constexpr auto newton_desc = unit_descriptor{ .exponent = gram_expo * acceleration_desc.exponent, .factor = 1.0f };
-		constexpr auto pascal_desc = unit_descriptor{ .exponent = newton_desc.exponent / squared_meter_desc.exponent, .factor = 1.0f };
-		constexpr auto joule_desc = unit_descriptor{ .exponent = newton_desc.exponent * meter_expo, .factor = 1.0f };
-		constexpr auto watt_desc = unit_descriptor{ .exponent = joule_desc.exponent * (second_expo ^ -1), .factor = 1.0f };
-		constexpr auto coulomb_desc = unit_descriptor{ .exponent = second_expo * ampere_expo, .factor = 1.0f };
-		constexpr auto volt_desc = unit_descriptor{ .exponent = watt_desc.exponent / ampere_expo, .factor = 1.0f };
-		constexpr auto farad_desc = unit_descriptor{ .exponent = coulomb_desc.exponent / volt_desc.exponent, .factor = 1.0f };
-		constexpr auto ohm_desc = unit_descriptor{ .exponent = volt_desc.exponent / ampere_expo, .factor = 1.0f };
-		constexpr auto siemens_desc = unit_descriptor{ .exponent = ohm_desc.exponent ^ -1, .factor = 1.0f };
-		constexpr auto weber_desc = unit_descriptor{ .exponent = volt_desc.exponent * second_expo, .factor = 1.0f };
-		constexpr auto tesla_desc = unit_descriptor{ .exponent = weber_desc.exponent / squared_meter_desc.exponent, .factor = 1.0f };
-		constexpr auto henry_desc = unit_descriptor{ .exponent = weber_desc.exponent / ampere_expo, .factor = 1.0f };
-		constexpr auto lux_desc = unit_descriptor{ .exponent = candela_expo / squared_meter_desc.exponent, .factor = 1.0f };
-		constexpr auto katal_desc = unit_descriptor{ .exponent = mol_expo / second_expo, .factor = 1.0f };
+		constexpr auto meter_desc = unit_descriptor{ .exponent = meter_expo, .factor = 1 };
+		constexpr auto second_desc = unit_descriptor{ .exponent = second_expo, .factor = 1 };
+		constexpr auto mol_desc = unit_descriptor{ .exponent = mol_expo, .factor = 1 };
+		constexpr auto ampere_desc = unit_descriptor{ .exponent = ampere_expo, .factor = 1 };
+		constexpr auto kelvin_desc = unit_descriptor{ .exponent = kelvin_expo, .factor = 1 };
+		constexpr auto candela_desc = unit_descriptor{ .exponent = candela_expo, .factor = 1 };
+		constexpr auto gram_desc = unit_descriptor{ .exponent = gram_expo, .factor = ratio{ 1, 1000 } };
+
+		constexpr auto squared_meter_desc = unit_descriptor{ .exponent = meter_expo ^ 2, .factor = 1 };
+		constexpr auto cubic_meter_desc = unit_descriptor{ .exponent = meter_expo ^ 3, .factor = 1 };
+
+		constexpr auto velocity_desc = unit_descriptor{ .exponent = meter_expo / second_expo, .factor = 1 };
+		constexpr auto acceleration_desc = unit_descriptor{ .exponent = velocity_desc.exponent / second_expo, .factor = 1 };
+
+		constexpr auto hertz_desc = unit_descriptor{ .exponent = second_expo ^ -1, .factor = 1 };
+		constexpr auto newton_desc = unit_descriptor{ .exponent = gram_expo * acceleration_desc.exponent, .factor = 1 };
+		constexpr auto pascal_desc = unit_descriptor{ .exponent = newton_desc.exponent / squared_meter_desc.exponent, .factor = 1 };
+		constexpr auto joule_desc = unit_descriptor{ .exponent = newton_desc.exponent * meter_expo, .factor = 1 };
+		constexpr auto watt_desc = unit_descriptor{ .exponent = joule_desc.exponent * (second_expo ^ -1), .factor = 1 };
+		constexpr auto coulomb_desc = unit_descriptor{ .exponent = second_expo * ampere_expo, .factor = 1 };
+		constexpr auto volt_desc = unit_descriptor{ .exponent = watt_desc.exponent / ampere_expo, .factor = 1 };
+		constexpr auto farad_desc = unit_descriptor{ .exponent = coulomb_desc.exponent / volt_desc.exponent, .factor = 1 };
+		constexpr auto ohm_desc = unit_descriptor{ .exponent = volt_desc.exponent / ampere_expo, .factor = 1 };
+		constexpr auto siemens_desc = unit_descriptor{ .exponent = ohm_desc.exponent ^ -1, .factor = 1 };
+		constexpr auto weber_desc = unit_descriptor{ .exponent = volt_desc.exponent * second_expo, .factor = 1 };
+		constexpr auto tesla_desc = unit_descriptor{ .exponent = weber_desc.exponent / squared_meter_desc.exponent, .factor = 1 };
+		constexpr auto henry_desc = unit_descriptor{ .exponent = weber_desc.exponent / ampere_expo, .factor = 1 };
+		constexpr auto lux_desc = unit_descriptor{ .exponent = candela_expo / squared_meter_desc.exponent, .factor = 1 };
+		constexpr auto katal_desc = unit_descriptor{ .exponent = mol_expo / second_expo, .factor = 1 };
 
 	};
 
+#ifdef SI_PROFILE_CONVERSIONS
+#ifndef SI_PROFILE_MAX_PAIRS
+#define SI_PROFILE_MAX_PAIRS 256
+#endif
+
+	//Where a scale conversion happened
+	enum class conversion_site
+	{
+		assign,
+		add,
+		subtract,
+		prefix,
+		//infer_cast created a quantity with a scale other than 1, e.g. the kilo_meter * meter product
+		scaled_result,
+	};
+
+	struct conversion_count
+	{
+		conversion_site site;
+		details::unit_descriptor from;
+		details::unit_descriptor to;
+		std::uint64_t count;
+	};
+
+	//Counts per conversion site and descriptor pair. Every thread counts into its own table without
+	//synchronization, tables of finished threads are added to the retired totals.
+	namespace details::profile
+	{
+		inline constexpr std::size_t max_pairs = SI_PROFILE_MAX_PAIRS;
+
+		struct table;
+
+		struct registry
+		{
+			std::mutex mutex;
+			std::vector<conversion_count> pairs;
+			std::vector<table*> live;
+			std::array<std::uint64_t, max_pairs> retired{};
+			std::atomic<std::uint64_t> dropped{ 0 };
+		};
+
+		inline registry& global()
+		{
+			static registry instance;
+			return instance;
+		}
+
+		struct table
+		{
+			std::array<std::atomic<std::uint64_t>, max_pairs> counts{};
+			//Counts at the last reset, guarded by the registry mutex. Only the owning thread writes `counts`,
+			//a reset records where it stands instead of storing into another thread's counters.
+			std::array<std::uint64_t, max_pairs> baseline{};
+
+			table()
+			{
+				auto lock = std::lock_guard(global().mutex);
+				global().live.push_back(this);
+			}
+
+			~table()
+			{
+				auto& r = global();
+				auto lock = std::lock_guard(r.mutex);
+				for (std::size_t i = 0; i < max_pairs; ++i)
+					r.retired[i] += counts[i].load(std::memory_order_relaxed) - baseline[i];
+				std::erase(r.live, this);
+			}
+		};
+
+		inline table& local()
+		{
+			thread_local table instance;
+			return instance;
+		}
+
+		inline std::size_t register_pair(conversion_site site, unit_descriptor from, unit_descriptor to)
+		{
+			auto& r = global();
+			auto lock = std::lock_guard(r.mutex);
+			r.pairs.push_back({ site, from, to, 0 });
+			return r.pairs.size() - 1;
+		}
+
+		template <conversion_site site, unit_descriptor from, unit_descriptor to>
+		void count()
+		{
+			static const std::size_t index = register_pair(site, from, to);
+			if (index >= max_pairs)
+			{
+				global().dropped.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+			//Only the owning thread writes, a load and a store avoid the locked add
+			auto& counter = local().counts[index];
+			counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		}
+
+		//Conversions by a factor of 1 and constant evaluation are not counted
+		template <conversion_site site, unit_descriptor from, unit_descriptor to>
+		constexpr void record()
+		{
+			if constexpr (conversion_factor(from, to) != ratio{})
+			{
+				if !consteval
+				{
+					count<site, from, to>();
+				}
+			}
+		}
+	}
+
+	//Every recorded pair with its count over all threads, the most frequent first.
+	//Counts of threads that are still converting may be a few increments behind.
+	[[nodiscard]] inline std::vector<conversion_count> conversion_report()
+	{
+		auto& r = details::profile::global();
+		auto lock = std::lock_guard(r.mutex);
+		auto report = r.pairs;
+		for (std::size_t i = 0; i < report.size() && i < details::profile::max_pairs; ++i)
+		{
+			report[i].count = r.retired[i];
+			for (const auto* table : r.live)
+				report[i].count += table->counts[i].load(std::memory_order_relaxed) - table->baseline[i];
+		}
+		std::stable_sort(report.begin(), report.end(), [](const auto& a, const auto& b) { return a.count > b.count; });
+		return report;
+	}
+
+	//Conversions of pairs beyond SI_PROFILE_MAX_PAIRS, which are counted but not attributed
+	[[nodiscard]] inline std::uint64_t dropped_conversions()
+	{
+		return details::profile::global().dropped.load(std::memory_order_relaxed);
+	}
+
+	inline void reset_conversion_counts()
+	{
+		auto& r = details::profile::global();
+		auto lock = std::lock_guard(r.mutex);
+		r.retired.fill(0);
+		for (auto* table : r.live)
+			for (std::size_t i = 0; i < details::profile::max_pairs; ++i)
+				table->baseline[i] = table->counts[i].load(std::memory_order_relaxed);
+		r.dropped.store(0, std::memory_order_relaxed);
+	}
+
+#define SI_PROFILE_CONVERSION(site, from, to) ::si::details::profile::record<::si::conversion_site::site, from, to>()
+#else
+#define SI_PROFILE_CONVERSION(site, from, to) ((void)0)
+#endif
+
 	template <details::unit_descriptor A, details::unit_descriptor B>
 	concept same_exponent_c = A
 		.exponent == B.exponent;
 
+	template <class U>
+	concept unit_c = std::derived_from<U, typename U::base_t>;
+
 	template <class T, details::unit_descriptor descriptor>
 	struct unit
 	{
@@ -128,7 +481,8 @@ namespace si
 		[[nodiscard]] constexpr auto operator=(this auto& v, unit<T, d_other> other)
 		{
 			constexpr auto factor = details::conversion_factor(d_other, descriptor);
-			v.value = factor * other.value;
+			SI_PROFILE_CONVERSION(assign, d_other, descriptor);
+			v.value = details::rescale<factor>(other.value);
 			return v;
 		}
 
@@ -137,7 +491,8 @@ namespace si
 		[[nodiscard]] constexpr auto operator+(this auto v, unit<T, d_other> other)
 		{
 			constexpr auto factor = details::conversion_factor(d_other, descriptor);
-			v.value += factor * other.value;
+			SI_PROFILE_CONVERSION(add, d_other, descriptor);
+			v.value += details::rescale<factor>(other.value);
 			return v;
 		}
 
@@ -150,7 +505,8 @@ namespace si
 		[[nodiscard]] constexpr auto operator-(this auto v, unit<T, d_other> other)
 		{
 			constexpr auto factor = details::conversion_factor(d_other, descriptor);
-			v.value -= factor * other.value;
+			SI_PROFILE_CONVERSION(subtract, d_other, descriptor);
+			v.value -= details::rescale<factor>(other.value);
 			return v;
 		}
 
@@ -180,19 +536,83 @@ namespace si
 
 
 
-	template<class T, details::unit_descriptor d>
-	constexpr auto kilo(unit<T, d> u) {
-		constexpr auto new_descriptor = details::unit_descriptor{ d.exponent, d.factor * 1000.0f };
-		return infer_cast(unit<T, new_descriptor>{u.value / 1000.0f});
+	//The SI prefixes as exact powers of ten
+	namespace prefix
+	{
+		inline constexpr auto quecto = details::ratio{ 1, 1, -30 };
+		inline constexpr auto ronto = details::ratio{ 1, 1, -27 };
+		inline constexpr auto yocto = details::ratio{ 1, 1, -24 };
+		inline constexpr auto zepto = details::ratio{ 1, 1, -21 };
+		inline constexpr auto atto = details::ratio{ 1, 1, -18 };
+		inline constexpr auto femto = details::ratio{ 1, 1, -15 };
+		inline constexpr auto pico = details::ratio{ 1, 1, -12 };
+		inline constexpr auto nano = details::ratio{ 1, 1, -9 };
+		inline constexpr auto micro = details::ratio{ 1, 1, -6 };
+		inline constexpr auto milli = details::ratio{ 1, 1, -3 };
+		inline constexpr auto centi = details::ratio{ 1, 1, -2 };
+		inline constexpr auto deci = details::ratio{ 1, 1, -1 };
+		inline constexpr auto deca = details::ratio{ 1, 1, 1 };
+		inline constexpr auto hecto = details::ratio{ 1, 1, 2 };
+		inline constexpr auto kilo = details::ratio{ 1, 1, 3 };
+		inline constexpr auto mega = details::ratio{ 1, 1, 6 };
+		inline constexpr auto giga = details::ratio{ 1, 1, 9 };
+		inline constexpr auto tera = details::ratio{ 1, 1, 12 };
+		inline constexpr auto peta = details::ratio{ 1, 1, 15 };
+		inline constexpr auto exa = details::ratio{ 1, 1, 18 };
+		inline constexpr auto zetta = details::ratio{ 1, 1, 21 };
+		inline constexpr auto yotta = details::ratio{ 1, 1, 24 };
+		inline constexpr auto ronna = details::ratio{ 1, 1, 27 };
+		inline constexpr auto quetta = details::ratio{ 1, 1, 30 };
 	}
 
-
-	template<class T, details::unit_descriptor d>
-	constexpr auto milli(unit<T, d> u) {
-		constexpr auto new_descriptor = details::unit_descriptor{ d.exponent, d.factor / 1000.0f };
-		return infer_cast(unit<T, new_descriptor>{u.value * 1000.0f});
+	namespace details
+	{
+		//Smallest to largest, the order of the symbols in si_format.h
+		constexpr auto si_prefixes = std::array{
+			prefix::quecto, prefix::ronto, prefix::yocto, prefix::zepto, prefix::atto, prefix::femto, prefix::pico, prefix::nano,
+			prefix::micro, prefix::milli, prefix::centi, prefix::deci, prefix::deca, prefix::hecto, prefix::kilo, prefix::mega,
+			prefix::giga, prefix::tera, prefix::peta, prefix::exa, prefix::zetta, prefix::yotta, prefix::ronna, prefix::quetta };
+
+		//The same quantity in the unit scaled by `factor`, e.g. 1.5 m as 0.0015 km
+		template <ratio factor, class T, unit_descriptor d>
+		constexpr auto apply_prefix(unit<T, d> u)
+		{
+			constexpr auto new_descriptor = d * factor;
+			SI_PROFILE_CONVERSION(prefix, d, new_descriptor);
+			return infer_cast(unit<T, new_descriptor>{ rescale<ratio{} / factor>(u.value) });
+		}
 	}
 
+	template<class T, details::unit_descriptor d> constexpr auto quecto(unit<T, d> u) { return details::apply_prefix<prefix::quecto>(u); }
+	template<class T, details::unit_descriptor d> constexpr auto ronto(unit<T, d> u) { return details::apply_prefix<prefix::ronto>(u); }
+	template<class T, details::unit_descriptor d> constexpr auto yocto(unit<T, d> u) { return details::apply_prefix<prefix::yocto>(u); }
+	template<class T, details::unit_descriptor d> constexpr auto zepto(unit<T, d> u) { return details::apply_prefix<prefix::zepto>(u); }
+	template<class T, details::unit_descriptor d> constexpr auto atto(unit<T, d> u) { return details::apply_prefix<prefix::atto>(u); }
+	template<class T, details::unit_descriptor d> constexpr auto femto(unit<T, d> u) { return details::apply_prefix<prefix::femto>(u); }
+	template<class T, details::unit_descriptor d> constexpr auto pico(unit<T, d> u) { return details::apply_prefix<prefix::pico>(u); }
+	template<class T, details::unit_descriptor d> constexpr auto nano(unit<T, d> u) { return details::apply_prefix<prefix::nano>(u); }
+	template<class T, details::unit_descriptor d> constexpr auto micro(unit<T, d> u) { return details::apply_prefix<prefix::micro>(u); }
+	template<class T, details::unit_descriptor d> constexpr auto milli(unit<T, d> u) { return details::apply_prefix<prefix::milli>(u); }
+	template<class T, details::unit_descriptor d> constexpr auto centi(unit<T, d> u) { return details::apply_prefix<prefix::centi>(u); }
+	template<class T, details::unit_descriptor d> constexpr auto deci(unit<T, d> u) { return details::apply_prefix<prefix::deci>(u); }
+	template<class T, details::unit_descriptor d> constexpr auto deca(unit<T, d> u) { return details::apply_prefix<prefix::deca>(u); }
+	template<class T, details::unit_descriptor d> constexpr auto hecto(unit<T, d> u) { return details::apply_prefix<prefix::hecto>(u); }
+	template<class T, details::unit_descriptor d> constexpr auto kilo(unit<T, d> u) { return details::apply_prefix<prefix::kilo>(u); }
+	template<class T, details::unit_descriptor d> constexpr auto mega(unit<T, d> u) { return details::apply_prefix<prefix::mega>(u); }
+	template<class T, details::unit_descriptor d> constexpr auto giga(unit<T, d> u) { return details::apply_prefix<prefix::giga>(u); }
+	template<class T, details::unit_descriptor d> constexpr auto tera(unit<T, d> u) { return details::apply_prefix<prefix::tera>(u); }
+	template<class T, details::unit_descriptor d> constexpr auto peta(unit<T, d> u) { return details::apply_prefix<prefix::peta>(u); }
+	template<class T, details::unit_descriptor d> constexpr auto exa(unit<T, d> u) { return details::apply_prefix<prefix::exa>(u); }
+	template<class T, details::unit_descriptor d> constexpr auto zetta(unit<T, d> u) { return details::apply_prefix<prefix::zetta>(u); }
+	template<class T, details::unit_descriptor d> constexpr auto yotta(unit<T, d> u) { return details::apply_prefix<prefix::yotta>(u); }
+	template<class T, details::unit_descriptor d> constexpr auto ronna(unit<T, d> u) { return details::apply_prefix<prefix::ronna>(u); }
+	template<class T, details::unit_descriptor d> constexpr auto quetta(unit<T, d> u) { return details::apply_prefix<prefix::quetta>(u); }
+
+	//A named unit scaled by an SI prefix, e.g. prefixed<prefix::nano, second<double>>.
+	//Products and quotients that land on a prefixed named unit infer this type unless a type is registered for it.
+	template <details::ratio Prefix, unit_c Named>
+	struct prefixed : unit<typename Named::type, Named::Descriptor() * Prefix> {};
+
 	//Base units
 	template<class T> struct meter : unit<T, details::meter_desc> {};
 	template<class T> struct second : unit<T, details::second_desc> {};
@@ -203,22 +623,22 @@ namespace si
 	template<class T> struct gram : unit<T, details::gram_desc> {};
 
 	//Kilo units
-	template<class T> struct kilo_meter : unit<T, details::meter_desc * 1e3f> {};
-	template<class T> struct kilo_second : unit<T, details::second_desc * 1e3f> {};
-	template<class T> struct kilo_mols : unit<T, details::mol_desc * 1e3f> {};
-	template<class T> struct kilo_ampere : unit<T, details::ampere_desc * 1e3f> {};
-	template<class T> struct kilo_kelvin : unit<T, details::kelvin_desc * 1e3f> {};
-	template<class T> struct kilo_candela : unit<T, details::candela_desc * 1e3f> {};
-	template<class T> struct kilo_gram : unit<T, details::gram_desc * 1e3f> {};
+	template<class T> struct kilo_meter : unit<T, details::meter_desc * 1000> {};
+	template<class T> struct kilo_second : unit<T, details::second_desc * 1000> {};
+	template<class T> struct kilo_mols : unit<T, details::mol_desc * 1000> {};
+	template<class T> struct kilo_ampere : unit<T, details::ampere_desc * 1000> {};
+	template<class T> struct kilo_kelvin : unit<T, details::kelvin_desc * 1000> {};
+	template<class T> struct kilo_candela : unit<T, details::candela_desc * 1000> {};
+	template<class T> struct kilo_gram : unit<T, details::gram_desc * 1000> {};
 
 	//mega
-	template<class T> struct mega_meter : unit<T, details::meter_desc * 1e6f> {};
-	template<class T> struct mega_second : unit<T, details::second_desc * 1e6f> {};
-	template<class T> struct mega_mols : unit<T, details::mol_desc * 1e6f> {};
-	template<class T> struct mega_ampere : unit<T, details::ampere_desc * 1e6f> {};
-	template<class T> struct mega_kelvin : unit<T, details::kelvin_desc * 1e6f> {};
-	template<class T> struct mega_candela : unit<T, details::candela_desc * 1e6f> {};
-	template<class T> struct ton : unit<T, details::gram_desc * 1e6f> {};
+	template<class T> struct mega_meter : unit<T, details::meter_desc * 1000000> {};
+	template<class T> struct mega_second : unit<T, details::second_desc * 1000000> {};
+	template<class T> struct mega_mols : unit<T, details::mol_desc * 1000000> {};
+	template<class T> struct mega_ampere : unit<T, details::ampere_desc * 1000000> {};
+	template<class T> struct mega_kelvin : unit<T, details::kelvin_desc * 1000000> {};
+	template<class T> struct mega_candela : unit<T, details::candela_desc * 1000000> {};
+	template<class T> struct ton : unit<T, details::gram_desc * 1000000> {};
 
 	//Time
 	template<class T> struct minute : unit<T, details::second_desc * 60> {};
@@ -297,53 +717,104 @@ namespace si
 	namespace details
 	{
 
-		template <class T, unit_descriptor d> struct inferer { using type = unit<T, d>; };
-
-
-		template <class T> struct inferer<T, meter<float>::Descriptor()> { using type = meter<T>; };
-		template <class T> struct inferer<T, second<float>::Descriptor()> { using type = second<T>; };
-		template <class T> struct inferer<T, mols<float>::Descriptor()> { using type = mols<T>; };
-		template <class T> struct inferer<T, ampere<float>::Descriptor()> { using type = ampere<T>; };
-		template <class T> struct inferer<T, kelvin<float>::Descriptor()> { using type = kelvin<T>; };
-		template <class T> struct inferer<T, candela<float>::Descriptor()> { using type = candela<T>; };
-		template <class T> struct inferer<T, gram<float>::Descriptor()> { using type = gram<T>; };
-
-		template <class T> struct inferer<T, kilo_meter<float>::Descriptor()> { using type = kilo_meter<T>; };
-		template <class T> struct inferer<T, kilo_second<float>::Descriptor()> { using type = kilo_second<T>; };
-		template <class T> struct inferer<T, kilo_mols<float>::Descriptor()> { using type = kilo_mols<T>; };
-		template <class T> struct inferer<T, kilo_ampere<float>::Descriptor()> { using type = kilo_ampere<T>; };
-		template <class T> struct inferer<T, kilo_kelvin<float>::Descriptor()> { using type = kilo_kelvin<T>; };
-		template <class T> struct inferer<T, kilo_candela<float>::Descriptor()> { using type = kilo_candela<T>; };
-		template <class T> struct inferer<T, kilo_gram<float>::Descriptor()> { using type = kilo_gram<T>; };
-
-		template <class T> struct inferer<T, mega_meter<float>::Descriptor()> { using type = mega_meter<T>; };
-		template <class T> struct inferer<T, mega_second<float>::Descriptor()> { using type = mega_second<T>; };
-		template <class T> struct inferer<T, mega_mols<float>::Descriptor()> { using type = mega_mols<T>; };
-		template <class T> struct inferer<T, mega_ampere<float>::Descriptor()> { using type = mega_ampere<T>; };
-		template <class T> struct inferer<T, mega_kelvin<float>::Descriptor()> { using type = mega_kelvin<T>; };
-		template <class T> struct inferer<T, mega_candela<float>::Descriptor()> { using type = mega_candela<T>; };
-		template <class T> struct inferer<T, ton<float>::Descriptor()> { using type = ton<T>; };
-
-		template <class T> struct inferer < T, unit_descriptor{ .exponent = {0, 0, 0, 0, 0, 0, 0}, .factor = 1.0f } > { using type = float; };
-		template <class T> struct inferer<T, meters_per_second<float>::Descriptor()> { using type = meters_per_second<T>; };
-		template <class T> struct inferer<T, meters_per_second_squared<float>::Descriptor()> { using type = meters_per_second_squared<T>; };
-		template <class T> struct inferer<T, SquareMeters<float>::Descriptor()> { using type = SquareMeters<T>; };
-		template <class T> struct inferer<T, CubicMeters<float>::Descriptor()> { using type = CubicMeters<T>; };
-		template <class T> struct inferer<T, hertz<float>::Descriptor()> { using type = hertz<T>; };
-		template <class T> struct inferer<T, newton<float>::Descriptor()> { using type = newton<T>; };
-		template <class T> struct inferer<T, pascal<float>::Descriptor()> { using type = pascal<T>; };
-		template <class T> struct inferer<T, joule<float>::Descriptor()> { using type = joule<T>; };
-		template <class T> struct inferer<T, watt<float>::Descriptor()> { using type = watt<T>; };
-		template <class T> struct inferer<T, coulomb<float>::Descriptor()> { using type = coulomb<T>; };
-		template <class T> struct inferer<T, volt<float>::Descriptor()> { using type = volt<T>; };
-		template <class T> struct inferer<T, farad<float>::Descriptor()> { using type = farad<T>; };
-		template <class T> struct inferer<T, ohm<float>::Descriptor()> { using type = ohm<T>; };
-		template <class T> struct inferer<T, siemens<float>::Descriptor()> { using type = siemens<T>; };
-		template <class T> struct inferer<T, weber<float>::Descriptor()> { using type = weber<T>; };
-		template <class T> struct inferer<T, tesla<float>::Descriptor()> { using type = tesla<T>; };
-		template <class T> struct inferer<T, henry<float>::Descriptor()> { using type = henry<T>; };
-		template <class T> struct inferer<T, lux<float>::Descriptor()> { using type = lux<T>; };
-		template <class T> struct inferer<T, katal<float>::Descriptor()> { using type = katal<T>; };
+		template <template <class> class... Named>
+		struct unit_list
+		{
+			static constexpr auto descriptors = std::array{ Named<float>::Descriptor()... };
+
+			template <std::size_t I, class T>
+			using type = std::tuple_element_t<I, std::tuple<Named<T>...>>;
+		};
+
+		//Named units every SI prefix applies to, the base units first in the order of their exponents
+		using prefixable_units = unit_list<meter, second, mols, ampere, kelvin, candela, gram,
+			hertz, newton, pascal, joule, watt, coulomb, volt, farad, ohm, siemens, weber, tesla, henry, lux, katal>;
+
+		//Positions in prefixable_units and si_prefixes, no_match when `d` is not a prefixed named unit
+		struct prefix_match
+		{
+			static constexpr std::size_t no_match = std::numeric_limits<std::size_t>::max();
+
+			std::size_t unit = no_match;
+			std::size_t prefix = no_match;
+
+			[[nodiscard]] constexpr bool found() const { return unit != no_match; }
+		};
+
+		consteval prefix_match find_prefix(unit_descriptor d)
+		{
+			for (std::size_t i = 0; i < prefixable_units::descriptors.size(); ++i)
+			{
+				if (prefixable_units::descriptors[i].exponent != d.exponent)
+					continue;
+				const auto scale = conversion_factor(d, prefixable_units::descriptors[i]);
+				for (std::size_t p = 0; p < si_prefixes.size(); ++p)
+					if (si_prefixes[p] == scale)
+						return { i, p };
+				//Exponents are unique in the list
+				return {};
+			}
+			return {};
+		}
+
+		template <unit_descriptor d, prefix_match match = find_prefix(d)>
+		struct generated_unit { template <class T> using type = prefixed<si_prefixes[match.prefix], prefixable_units::type<match.unit, T>>; };
+
+		template <unit_descriptor d>
+		struct generated_unit<d, prefix_match{}> { template <class T> using type = unit<T, d>; };
+
+		//Named type registered for a descriptor. Registrations are full specializations, which the compiler
+		//finds with a direct lookup on the descriptor value instead of matching partial specializations one by one.
+		//Other descriptors fall back to the generated prefixed named unit, or to the plain unit.
+		template <unit_descriptor d> struct named_unit : generated_unit<d> {};
+
+
+		template <> struct named_unit<meter<float>::Descriptor()> { template <class T> using type = meter<T>; };
+		template <> struct named_unit<second<float>::Descriptor()> { template <class T> using type = second<T>; };
+		template <> struct named_unit<mols<float>::Descriptor()> { template <class T> using type = mols<T>; };
+		template <> struct named_unit<ampere<float>::Descriptor()> { template <class T> using type = ampere<T>; };
+		template <> struct named_unit<kelvin<float>::Descriptor()> { template <class T> using type = kelvin<T>; };
+		template <> struct named_unit<candela<float>::Descriptor()> { template <class T> using type = candela<T>; };
+		template <> struct named_unit<gram<float>::Descriptor()> { template <class T> using type = gram<T>; };
+
+		template <> struct named_unit<kilo_meter<float>::Descriptor()> { template <class T> using type = kilo_meter<T>; };
+		template <> struct named_unit<kilo_second<float>::Descriptor()> { template <class T> using type = kilo_second<T>; };
+		template <> struct named_unit<kilo_mols<float>::Descriptor()> { template <class T> using type = kilo_mols<T>; };
+		template <> struct named_unit<kilo_ampere<float>::Descriptor()> { template <class T> using type = kilo_ampere<T>; };
+		template <> struct named_unit<kilo_kelvin<float>::Descriptor()> { template <class T> using type = kilo_kelvin<T>; };
+		template <> struct named_unit<kilo_candela<float>::Descriptor()> { template <class T> using type = kilo_candela<T>; };
+		template <> struct named_unit<kilo_gram<float>::Descriptor()> { template <class T> using type = kilo_gram<T>; };
+
+		template <> struct named_unit<mega_meter<float>::Descriptor()> { template <class T> using type = mega_meter<T>; };
+		template <> struct named_unit<mega_second<float>::Descriptor()> { template <class T> using type = mega_second<T>; };
+		template <> struct named_unit<mega_mols<float>::Descriptor()> { template <class T> using type = mega_mols<T>; };
+		template <> struct named_unit<mega_ampere<float>::Descriptor()> { template <class T> using type = mega_ampere<T>; };
+		template <> struct named_unit<mega_kelvin<float>::Descriptor()> { template <class T> using type = mega_kelvin<T>; };
+		template <> struct named_unit<mega_candela<float>::Descriptor()> { template <class T> using type = mega_candela<T>; };
+		template <> struct named_unit<ton<float>::Descriptor()> { template <class T> using type = ton<T>; };
+
+		template <> struct named_unit<unit_descriptor{ .exponent = {0, 0, 0, 0, 0, 0, 0}, .factor = 1 }> { template <class T> using type = T; };
+		template <> struct named_unit<meters_per_second<float>::Descriptor()> { template <class T> using type = meters_per_second<T>; };
+		template <> struct named_unit<meters_per_second_squared<float>::Descriptor()> { template <class T> using type = meters_per_second_squared<T>; };
+		template <> struct named_unit<SquareMeters<float>::Descriptor()> { template <class T> using type = SquareMeters<T>; };
+		template <> struct named_unit<CubicMeters<float>::Descriptor()> { template <class T> using type = CubicMeters<T>; };
+		template <> struct named_unit<hertz<float>::Descriptor()> { template <class T> using type = hertz<T>; };
+		template <> struct named_unit<newton<float>::Descriptor()> { template <class T> using type = newton<T>; };
+		template <> struct named_unit<pascal<float>::Descriptor()> { template <class T> using type = pascal<T>; };
+		template <> struct named_unit<joule<float>::Descriptor()> { template <class T> using type = joule<T>; };
+		template <> struct named_unit<watt<float>::Descriptor()> { template <class T> using type = watt<T>; };
+		template <> struct named_unit<coulomb<float>::Descriptor()> { template <class T> using type = coulomb<T>; };
+		template <> struct named_unit<volt<float>::Descriptor()> { template <class T> using type = volt<T>; };
+		template <> struct named_unit<farad<float>::Descriptor()> { template <class T> using type = farad<T>; };
+		template <> struct named_unit<ohm<float>::Descriptor()> { template <class T> using type = ohm<T>; };
+		template <> struct named_unit<siemens<float>::Descriptor()> { template <class T> using type = siemens<T>; };
+		template <> struct named_unit<weber<float>::Descriptor()> { template <class T> using type = weber<T>; };
+		template <> struct named_unit<tesla<float>::Descriptor()> { template <class T> using type = tesla<T>; };
+		template <> struct named_unit<henry<float>::Descriptor()> { template <class T> using type = henry<T>; };
+		template <> struct named_unit<lux<float>::Descriptor()> { template <class T> using type = lux<T>; };
+		template <> struct named_unit<katal<float>::Descriptor()> { template <class T> using type = katal<T>; };
+
+		template <class T, unit_descriptor d> struct inferer { using type = typename named_unit<d>::template type<T>; };
 
 		template <class T, unit_descriptor d>
 		using inferer_t = typename inferer<T, d>::type;
@@ -352,6 +823,7 @@ namespace si
 	template <class T, details::unit_descriptor d>
 	[[nodiscard]] constexpr auto infer_cast(unit<T, d> value)
 	{
+		SI_PROFILE_CONVERSION(scaled_result, (details::unit_descriptor{ d.exponent, details::ratio{} }), d);
 		return typename details::inferer<T, d>::type{ value.value };
 	};
 
@@ -377,10 +849,58 @@ namespace si
 	[[nodiscard]] constexpr auto operator/(T factor, unit<T, descriptor> v)
 	{
 		constexpr auto new_exponent = details::invert_exponents(descriptor.exponent);
-		constexpr auto new_desc = details::unit_descriptor{ new_exponent, descriptor.factor };
+		constexpr auto new_desc = details::unit_descriptor{ new_exponent, details::ratio{} / descriptor.factor };
 		return infer_cast(unit<T, new_desc>{factor / v.value});
 	}
 
+	namespace details
+	{
+		//Value type of an operation on two different value types, the usual arithmetic conversions:
+		//float and double give double, int and float give float, std::float16_t and float give float
+		template <class A, class B>
+		using promote_t = std::common_type_t<A, B>;
+
+		template <class T, unit_descriptor d, class From>
+		constexpr auto promote(unit<From, d> u)
+		{
+			return infer_cast(unit<T, d>{ static_cast<T>(u.value) });
+		}
+	}
+
+	//Operands with different value types are both converted to the promoted type first,
+	//the result then follows the rules of the same type operators
+	template <class A, details::unit_descriptor da, class B, details::unit_descriptor db>
+		requires (!std::same_as<A, B>) && same_exponent_c<da, db>
+	[[nodiscard]] constexpr auto operator+(unit<A, da> a, unit<B, db> b)
+	{
+		using T = details::promote_t<A, B>;
+		return details::promote<T>(a) + unit<T, db>{ static_cast<T>(b.value) };
+	}
+
+	template <class A, details::unit_descriptor da, class B, details::unit_descriptor db>
+		requires (!std::same_as<A, B>) && same_exponent_c<da, db>
+	[[nodiscard]] constexpr auto operator-(unit<A, da> a, unit<B, db> b)
+	{
+		using T = details::promote_t<A, B>;
+		return details::promote<T>(a) - unit<T, db>{ static_cast<T>(b.value) };
+	}
+
+	template <class A, details::unit_descriptor da, class B, details::unit_descriptor db>
+		requires (!std::same_as<A, B>)
+	[[nodiscard]] constexpr auto operator*(unit<A, da> a, unit<B, db> b)
+	{
+		using T = details::promote_t<A, B>;
+		return unit<T, da>{ static_cast<T>(a.value) } * unit<T, db>{ static_cast<T>(b.value) };
+	}
+
+	template <class A, details::unit_descriptor da, class B, details::unit_descriptor db>
+		requires (!std::same_as<A, B>)
+	[[nodiscard]] constexpr auto operator/(unit<A, da> a, unit<B, db> b)
+	{
+		using T = details::promote_t<A, B>;
+		return unit<T, da>{ static_cast<T>(a.value) } / unit<T, db>{ static_cast<T>(b.value) };
+	}
+
 
 
 
@@ -0,0 +1,413 @@
+#pragma once
+#include "si.h"
+#include "si_container.h"
+#include "si_convert.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <execution>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <stop_token>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace si
+{
+
+	namespace execution
+	{
+		//Reusable worker threads for the parallel algorithms, the calling thread takes part in every job
+		class thread_pool
+		{
+		public:
+			explicit thread_pool(unsigned threads = std::max(1u, std::thread::hardware_concurrency()))
+			{
+				for (unsigned i = 1; i < threads; ++i)
+					workers_.emplace_back([this](std::stop_token stop) { work(stop); });
+			}
+
+			thread_pool(const thread_pool&) = delete;
+			thread_pool& operator=(const thread_pool&) = delete;
+
+			[[nodiscard]] unsigned size() const
+			{
+				return static_cast<unsigned>(workers_.size()) + 1;
+			}
+
+			//Calls f(i) for every i in [0, count) and returns once all calls are done, f must not throw
+			template <class F>
+			void parallel_for(std::size_t count, F&& f)
+			{
+				std::scoped_lock submit(submit_mutex_);
+				{
+					std::scoped_lock lock(mutex_);
+					context_ = const_cast<void*>(static_cast<const void*>(std::addressof(f)));
+					invoke_ = [](void* context, std::size_t i) { (*static_cast<std::remove_reference_t<F>*>(context))(i); };
+					count_ = count;
+					next_.store(0, std::memory_order_relaxed);
+					pending_ = workers_.size();
+					++generation_;
+				}
+				wake_.notify_all();
+
+				run_job();
+
+				std::unique_lock lock(mutex_);
+				done_.wait(lock, [this] { return pending_ == 0; });
+			}
+
+		private:
+			void run_job()
+			{
+				for (auto i = next_.fetch_add(1, std::memory_order_relaxed); i < count_; i = next_.fetch_add(1, std::memory_order_relaxed))
+					invoke_(context_, i);
+			}
+
+			void work(std::stop_token stop)
+			{
+				std::uint64_t seen = 0;
+				while (true)
+				{
+					std::unique_lock lock(mutex_);
+					if (!wake_.wait(lock, stop, [&] { return generation_ != seen; }))
+						return;
+					seen = generation_;
+					lock.unlock();
+
+					run_job();
+
+					lock.lock();
+					if (--pending_ == 0)
+						done_.notify_one();
+				}
+			}
+
+			std::mutex submit_mutex_;
+			std::mutex mutex_;
+			std::condition_variable_any wake_;
+			std::condition_variable done_;
+			std::uint64_t generation_ = 0;
+			std::size_t pending_ = 0;
+			void* context_ = nullptr;
+			void (*invoke_)(void*, std::size_t) = nullptr;
+			std::size_t count_ = 0;
+			std::atomic<std::size_t> next_ = 0;
+			std::vector<std::jthread> workers_;
+		};
+
+		struct sequenced_policy {};
+		struct parallel_policy {};
+		struct pool_policy { thread_pool* pool; };
+
+		//Single thread
+		inline constexpr sequenced_policy seq{};
+		//std::execution::par_unseq
+		inline constexpr parallel_policy par{};
+		//An explicit si::execution::thread_pool
+		inline pool_policy on(thread_pool& pool) { return { &pool }; }
+	}
+
+	//How sums are accumulated. Kahan relies on strict floating point semantics, do not combine it with -ffast-math.
+	//Wide sums pairwise in a wider type, double for float values and intmax_t for integers, and rounds once at the end.
+	namespace summation
+	{
+		struct naive_t {};
+		struct pairwise_t {};
+		struct kahan_t {};
+		struct wide_t {};
+
+		inline constexpr naive_t naive{};
+		inline constexpr pairwise_t pairwise{};
+		inline constexpr kahan_t kahan{};
+		inline constexpr wide_t wide{};
+	}
+
+	namespace details
+	{
+		template <class P>
+		concept execution_policy_c = std::same_as<P, execution::sequenced_policy> || std::same_as<P, execution::parallel_policy> || std::same_as<P, execution::pool_policy>;
+
+		template <class S>
+		concept summation_c = std::same_as<S, summation::naive_t> || std::same_as<S, summation::pairwise_t> || std::same_as<S, summation::kahan_t>
+			|| std::same_as<S, summation::wide_t>;
+
+		template <class T>
+		struct wide_accumulator { using type = T; };
+
+		template <>
+		struct wide_accumulator<float> { using type = double; };
+
+		template <std::signed_integral T>
+		struct wide_accumulator<T> { using type = std::intmax_t; };
+
+		template <std::unsigned_integral T>
+		struct wide_accumulator<T> { using type = std::uintmax_t; };
+
+		//Type the terms are added in
+		template <class T, class S>
+		using accumulator_t = std::conditional_t<std::same_as<S, summation::wide_t>, typename wide_accumulator<T>::type, T>;
+
+		//Quantity ranges and contiguous ranges of units, seen as their raw values
+		template <class R>
+		concept unit_range_c = quantity_range_c<R> || (std::ranges::contiguous_range<R> && unit_c<std::ranges::range_value_t<R>>);
+
+		template <class R>
+		struct unit_range_traits
+		{
+			using unit_type = std::ranges::range_value_t<R>;
+
+			static auto values(const R& range)
+			{
+				return std::span<const typename unit_type::type>(raw_values(std::ranges::data(range)), std::ranges::size(range));
+			}
+		};
+
+		template <class R>
+			requires quantity_range_c<R>
+		struct unit_range_traits<R>
+		{
+			using unit_type = range_unit_t<R>;
+
+			static auto values(const R& range)
+			{
+				return std::as_const(range).values();
+			}
+		};
+
+		template <class R>
+		using unit_range_t = typename unit_range_traits<std::remove_cvref_t<R>>::unit_type;
+
+		template <class R>
+		auto range_values(const R& range)
+		{
+			return unit_range_traits<std::remove_cvref_t<R>>::values(range);
+		}
+
+		//Kahan sum, `error` holds the low order bits lost by the last addition and is fed back into the next one
+		template <class T>
+		struct compensated
+		{
+			T sum{};
+			T error{};
+
+			constexpr void add(T value)
+			{
+				const auto corrected = value - error;
+				const auto total = sum + corrected;
+				error = (total - sum) - corrected;
+				sum = total;
+			}
+
+			friend constexpr compensated operator+(compensated a, compensated b)
+			{
+				a.add(b.sum);
+				a.add(-b.error);
+				return a;
+			}
+
+			[[nodiscard]] constexpr T value() const
+			{
+				return sum - error;
+			}
+		};
+
+		constexpr std::size_t pairwise_block = 128;
+
+		template <class T, class F>
+		T pairwise_sum(std::size_t first, std::size_t last, const F& term)
+		{
+			if (last - first <= pairwise_block)
+			{
+				T sum{};
+				for (auto i = first; i < last; ++i)
+					sum += term(i);
+				return sum;
+			}
+			const auto middle = first + (last - first) / 2;
+			return pairwise_sum<T>(first, middle, term) + pairwise_sum<T>(middle, last, term);
+		}
+
+		template <class T, class S, class F>
+		compensated<T> sum_chunk(std::size_t first, std::size_t last, const F& term)
+		{
+			auto result = compensated<T>{};
+			if constexpr (std::same_as<S, summation::kahan_t>)
+			{
+				for (auto i = first; i < last; ++i)
+					result.add(term(i));
+			}
+			else if constexpr (std::same_as<S, summation::pairwise_t>)
+			{
+				result.sum = pairwise_sum<T>(first, last, term);
+			}
+			else
+			{
+				for (auto i = first; i < last; ++i)
+					result.sum += term(i);
+			}
+			return result;
+		}
+
+		//Enough chunks to balance the load, few enough that combining them costs nothing
+		inline std::size_t chunk_count(std::size_t n)
+		{
+			const std::size_t threads = std::max(1u, std::thread::hardware_concurrency());
+			return std::clamp<std::size_t>(n / 4096, 1, threads * 4);
+		}
+
+		//Reduces [0, n) chunk by chunk, partial results are always combined in chunk order so runs are repeatable
+		//for the same policy on the same machine. seq reduces one chunk and the chunk count of the parallel
+		//policies follows hardware_concurrency, so results may differ in the last bits between the two.
+		template <class R, class Policy, class Chunk, class Combine>
+		R parallel_reduce(const Policy& policy, std::size_t n, R identity, const Chunk& chunk, const Combine& combine)
+		{
+			if constexpr (std::same_as<Policy, execution::sequenced_policy>)
+				return combine(identity, chunk(std::size_t{ 0 }, n));
+			else
+			{
+				const auto chunks = chunk_count(n);
+				auto partials = std::vector<R>(chunks, identity);
+				const auto run = [&](std::size_t c) { partials[c] = chunk(n * c / chunks, n * (c + 1) / chunks); };
+
+				if constexpr (std::same_as<Policy, execution::parallel_policy>)
+				{
+					auto indices = std::views::iota(std::size_t{ 0 }, chunks);
+					std::for_each(std::execution::par_unseq, indices.begin(), indices.end(), run);
+				}
+				else
+					policy.pool->parallel_for(chunks, run);
+
+				return std::accumulate(partials.begin(), partials.end(), identity, combine);
+			}
+		}
+
+		template <class T, class S, class Policy, class F>
+		T sum_terms(const Policy& policy, std::size_t n, const F& term)
+		{
+			using A = accumulator_t<T, S>;
+			using chunk_summation = std::conditional_t<std::same_as<S, summation::wide_t>, summation::pairwise_t, S>;
+			const auto chunk = [&term](std::size_t first, std::size_t last) { return sum_chunk<A, chunk_summation>(first, last, term); };
+			return static_cast<T>(parallel_reduce(policy, n, compensated<A>{}, chunk, std::plus<>{}).value());
+		}
+	}
+
+	template <details::execution_policy_c Policy, details::unit_range_c R, details::summation_c S = summation::pairwise_t>
+	[[nodiscard]] auto sum(const Policy& policy, const R& range, S = {})
+	{
+		using U = details::unit_range_t<R>;
+		using T = typename U::type;
+
+		const auto values = details::range_values(range);
+		return U{ details::sum_terms<T, S>(policy, values.size(), [p = values.data()](std::size_t i) { return p[i]; }) };
+	}
+
+	template <details::unit_range_c R, details::summation_c S = summation::pairwise_t>
+	[[nodiscard]] auto sum(const R& range, S summation = {})
+	{
+		return si::sum(execution::seq, range, summation);
+	}
+
+	template <details::execution_policy_c Policy, details::unit_range_c R, details::summation_c S = summation::pairwise_t>
+	[[nodiscard]] auto mean(const Policy& policy, const R& range, S summation = {})
+	{
+		using U = details::unit_range_t<R>;
+		using T = typename U::type;
+
+		const auto size = details::range_values(range).size();
+		assert(size != 0);
+		return U{ si::sum(policy, range, summation).value / static_cast<T>(size) };
+	}
+
+	template <details::unit_range_c R, details::summation_c S = summation::pairwise_t>
+	[[nodiscard]] auto mean(const R& range, S summation = {})
+	{
+		return si::mean(execution::seq, range, summation);
+	}
+
+	//Sum of a[i] * b[i], the result has the unit of a[0] * b[0]
+	template <details::execution_policy_c Policy, details::unit_range_c A, details::unit_range_c B, details::summation_c S = summation::pairwise_t>
+	[[nodiscard]] auto dot(const Policy& policy, const A& a, const B& b, S = {})
+	{
+		using UA = details::unit_range_t<A>;
+		using UB = details::unit_range_t<B>;
+		using T = typename UA::type;
+		const auto lhs = details::range_values(a);
+		const auto rhs = details::range_values(b);
+		assert(lhs.size() == rhs.size());
+
+		using A = details::accumulator_t<T, S>;
+		const auto total = details::sum_terms<T, S>(policy, lhs.size(), [p = lhs.data(), q = rhs.data()](std::size_t i) { return static_cast<A>(p[i]) * static_cast<A>(q[i]); });
+		return details::make_product<UA, UB>(total);
+	}
+
+	template <details::unit_range_c A, details::unit_range_c B, details::summation_c S = summation::pairwise_t>
+	[[nodiscard]] auto dot(const A& a, const B& b, S summation = {})
+	{
+		return si::dot(execution::seq, a, b, summation);
+	}
+
+	//Euclidean norm, sqrt(dot(x, x)) in the unit of x
+	template <details::execution_policy_c Policy, details::unit_range_c R, details::summation_c S = summation::pairwise_t>
+	[[nodiscard]] auto norm(const Policy& policy, const R& range, S = {})
+	{
+		using U = details::unit_range_t<R>;
+		using T = typename U::type;
+
+		const auto values = details::range_values(range);
+		using A = details::accumulator_t<T, S>;
+		const auto squares = details::sum_terms<T, S>(policy, values.size(), [p = values.data()](std::size_t i) { return static_cast<A>(p[i]) * static_cast<A>(p[i]); });
+		return U{ static_cast<T>(std::sqrt(squares)) };
+	}
+
+	template <details::unit_range_c R, details::summation_c S = summation::pairwise_t>
+	[[nodiscard]] auto norm(const R& range, S summation = {})
+	{
+		return si::norm(execution::seq, range, summation);
+	}
+
+	template <details::execution_policy_c Policy, details::unit_range_c R>
+	[[nodiscard]] auto min(const Policy& policy, const R& range)
+	{
+		using U = details::unit_range_t<R>;
+
+		const auto values = details::range_values(range);
+		assert(!values.empty());
+		const auto chunk = [p = values.data()](std::size_t first, std::size_t last) { return *std::min_element(p + first, p + last); };
+		const auto combine = [](auto a, auto b) { return b < a ? b : a; };
+		return U{ details::parallel_reduce(policy, values.size(), values.front(), chunk, combine) };
+	}
+
+	template <details::unit_range_c R>
+	[[nodiscard]] auto min(const R& range)
+	{
+		return si::min(execution::seq, range);
+	}
+
+	template <details::execution_policy_c Policy, details::unit_range_c R>
+	[[nodiscard]] auto max(const Policy& policy, const R& range)
+	{
+		using U = details::unit_range_t<R>;
+
+		const auto values = details::range_values(range);
+		assert(!values.empty());
+		const auto chunk = [p = values.data()](std::size_t first, std::size_t last) { return *std::max_element(p + first, p + last); };
+		const auto combine = [](auto a, auto b) { return a < b ? b : a; };
+		return U{ details::parallel_reduce(policy, values.size(), values.front(), chunk, combine) };
+	}
+
+	template <details::unit_range_c R>
+	[[nodiscard]] auto max(const R& range)
+	{
+		return si::max(execution::seq, range);
+	}
+}
@@ -0,0 +1,183 @@
+#pragma once
+#include "si.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <thread>
+
+namespace si
+{
+
+	namespace details
+	{
+		//Fixed instead of std::hardware_destructive_interference_size, which may differ between translation units
+		constexpr std::size_t cache_line = 64;
+
+		//Quantities `Unit + Other` accepts, the same rule as the scalar operators
+		template <class Unit, class Other>
+		concept addable_c = unit_c<Other> && std::same_as<typename Other::type, typename Unit::type>
+			&& same_exponent_c<Unit::Descriptor(), Other::Descriptor()> && requires(Unit u, Other o) { u + o; };
+
+		//Scale conversion happens before the atomic operation, the atomic only ever sees values in the scale of Unit
+		template <class Unit, class Other>
+		constexpr typename Unit::type value_in(Other other)
+		{
+			return rescale<conversion_factor(Other::Descriptor(), Unit::Descriptor())>(other.value);
+		}
+
+		//Threads get consecutive indices, so up to shards() threads never share a shard
+		inline std::size_t thread_index()
+		{
+			static std::atomic<std::size_t> next{ 0 };
+			thread_local const std::size_t index = next.fetch_add(1, std::memory_order_relaxed);
+			return index;
+		}
+	}
+
+	//std::atomic of the raw value of a quantity. Every same dimension quantity is accepted and rescaled first.
+	template <unit_c Unit>
+	class atomic
+	{
+	public:
+		using unit_type = Unit;
+		using type = typename Unit::type;
+
+		static constexpr bool is_always_lock_free = std::atomic<type>::is_always_lock_free;
+
+		constexpr atomic() = default;
+		constexpr atomic(Unit initial) : value_(initial.value) {}
+
+		atomic(const atomic&) = delete;
+		atomic& operator=(const atomic&) = delete;
+
+		[[nodiscard]] bool is_lock_free() const { return value_.is_lock_free(); }
+
+		[[nodiscard]] Unit load(std::memory_order order = std::memory_order_seq_cst) const
+		{
+			return Unit{ value_.load(order) };
+		}
+
+		operator Unit() const { return load(); }
+
+		template <class Other>
+			requires details::addable_c<Unit, Other>
+		void store(Other desired, std::memory_order order = std::memory_order_seq_cst)
+		{
+			value_.store(details::value_in<Unit>(desired), order);
+		}
+
+		template <class Other>
+			requires details::addable_c<Unit, Other>
+		Unit exchange(Other desired, std::memory_order order = std::memory_order_seq_cst)
+		{
+			return Unit{ value_.exchange(details::value_in<Unit>(desired), order) };
+		}
+
+		bool compare_exchange_weak(Unit& expected, Unit desired, std::memory_order order = std::memory_order_seq_cst)
+		{
+			return value_.compare_exchange_weak(expected.value, desired.value, order);
+		}
+
+		bool compare_exchange_strong(Unit& expected, Unit desired, std::memory_order order = std::memory_order_seq_cst)
+		{
+			return value_.compare_exchange_strong(expected.value, desired.value, order);
+		}
+
+		//Returns the value before the addition
+		template <class Other>
+			requires details::addable_c<Unit, Other>
+		Unit fetch_add(Other other, std::memory_order order = std::memory_order_seq_cst)
+		{
+			return Unit{ value_.fetch_add(details::value_in<Unit>(other), order) };
+		}
+
+		template <class Other>
+			requires details::addable_c<Unit, Other>
+		Unit fetch_sub(Other other, std::memory_order order = std::memory_order_seq_cst)
+		{
+			return Unit{ value_.fetch_sub(details::value_in<Unit>(other), order) };
+		}
+
+		template <class Other>
+			requires details::addable_c<Unit, Other>
+		atomic& operator+=(Other other)
+		{
+			fetch_add(other);
+			return *this;
+		}
+
+		template <class Other>
+			requires details::addable_c<Unit, Other>
+		atomic& operator-=(Other other)
+		{
+			fetch_sub(other);
+			return *this;
+		}
+
+	private:
+		std::atomic<type> value_{};
+	};
+
+	//A counter split over cache line sized shards. Each thread adds to its own shard with a relaxed
+	//fetch_add, so writers on different cores do not bounce a shared cache line. Reads sum all shards.
+	template <unit_c Unit>
+	class sharded_counter
+	{
+	public:
+		using unit_type = Unit;
+		using type = typename Unit::type;
+
+		//Rounded up to a power of two, by default one shard per hardware thread
+		explicit sharded_counter(std::size_t shards = std::max(1u, std::thread::hardware_concurrency())) :
+			mask_(std::bit_ceil(std::max<std::size_t>(shards, 1)) - 1),
+			shards_(std::make_unique<shard[]>(mask_ + 1))
+		{
+		}
+
+		[[nodiscard]] std::size_t shards() const { return mask_ + 1; }
+
+		template <class Other>
+			requires details::addable_c<Unit, Other>
+		void add(Other other)
+		{
+			shards_[details::thread_index() & mask_].value.fetch_add(details::value_in<Unit>(other), std::memory_order_relaxed);
+		}
+
+		template <class Other>
+			requires details::addable_c<Unit, Other>
+		sharded_counter& operator+=(Other other)
+		{
+			add(other);
+			return *this;
+		}
+
+		//Sum of all shards. Adds running at the same time may or may not be included.
+		[[nodiscard]] Unit load() const
+		{
+			type sum{};
+			for (std::size_t i = 0; i <= mask_; ++i)
+				sum += shards_[i].value.load(std::memory_order_relaxed);
+			return Unit{ sum };
+		}
+
+		//Returns the sum and starts over from zero, no add is lost or counted twice
+		Unit reset()
+		{
+			type sum{};
+			for (std::size_t i = 0; i <= mask_; ++i)
+				sum += shards_[i].value.exchange(type{}, std::memory_order_relaxed);
+			return Unit{ sum };
+		}
+
+	private:
+		struct alignas(details::cache_line) shard
+		{
+			std::atomic<type> value{};
+		};
+
+		std::size_t mask_;
+		std::unique_ptr<shard[]> shards_;
+	};
+}
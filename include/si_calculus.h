@@ -0,0 +1,340 @@
+#pragma once
+#include "si.h"
+#include "si_container.h"
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+//Integration and differentiation of sampled signals. The result units come from the scalar operators,
+//watt samples over second give joule, meter samples over second give meters_per_second.
+//integrator and differentiator take the signal in chunks and keep only the last few samples between them.
+namespace si
+{
+
+	namespace integration
+	{
+		struct trapezoid_t {};
+		struct simpson_t {};
+
+		inline constexpr trapezoid_t trapezoid{};
+		inline constexpr simpson_t simpson{};
+	}
+
+	namespace details
+	{
+		template <class R>
+		concept integration_rule_c = std::same_as<R, integration::trapezoid_t> || std::same_as<R, integration::simpson_t>;
+
+		//Sum with independent lane accumulators, which the compiler keeps in SIMD registers
+		//without reassociating a single floating point sum
+		template <class T, class F>
+		T lane_sum(std::size_t n, const F& term)
+		{
+			constexpr std::size_t lanes = 16;
+			auto acc = std::array<T, lanes>{};
+			std::size_t i = 0;
+			for (; i + lanes <= n; i += lanes)
+				for (std::size_t j = 0; j < lanes; ++j)
+					acc[j] += term(i + j);
+
+			T sum{};
+			for (; i < n; ++i)
+				sum += term(i);
+			for (std::size_t width = lanes / 2; width != 0; width /= 2)
+				for (std::size_t j = 0; j < width; ++j)
+					acc[j] += acc[j + width];
+			return sum + acc[0];
+		}
+
+		//Simpson over two intervals of widths h0 and h1
+		template <class T>
+		constexpr T simpson_pair(T h0, T h1, T y0, T y1, T y2)
+		{
+			const auto h = h0 + h1;
+			return h / 6 * ((2 - h1 / h0) * y0 + h * h / (h0 * h1) * y1 + (2 - h0 / h1) * y2);
+		}
+
+		//Last interval [x1, x2] of an odd count, from the parabola through the last three samples
+		template <class T>
+		constexpr T simpson_tail(T h0, T h1, T y0, T y1, T y2)
+		{
+			const auto alpha = (2 * h1 * h1 + 3 * h0 * h1) / (6 * (h0 + h1));
+			const auto beta = (h1 * h1 + 3 * h0 * h1) / (6 * h0);
+			const auto eta = h1 * h1 * h1 / (6 * h0 * (h0 + h1));
+			return alpha * y2 + beta * y1 - eta * y0;
+		}
+
+		template <class Y, class X>
+		using integral_t = decltype(make_product<Y, X>(typename Y::type{}));
+
+		template <class Y, class X>
+		using derivative_unit_t = typename element_unit<decltype(std::declval<Y>() / std::declval<X>()), typename Y::type>::type;
+	}
+
+	//Running integral of samples `Y` over `X`. Construct with a sample spacing for uniform sampling,
+	//or without one and push timestamps next to the samples.
+	template <unit_c Y, unit_c X, details::integration_rule_c Rule = integration::trapezoid_t>
+	class integrator
+	{
+	public:
+		using type = typename Y::type;
+		using result_type = details::integral_t<Y, X>;
+		static_assert(std::same_as<type, typename X::type>, "Samples and spacing need the same value type");
+
+		integrator() = default;
+		explicit integrator(X spacing, Rule = {}) : spacing_(spacing.value), uniform_(true) {}
+
+		//Uniform sampling only
+		void push(quantity_span<const Y> samples)
+		{
+			assert(uniform_);
+			push_values(samples.data(), nullptr, samples.size());
+		}
+
+		void push(quantity_span<const Y> samples, quantity_span<const X> at)
+		{
+			assert(!uniform_ && samples.size() == at.size());
+			push_values(samples.data(), at.data(), samples.size());
+		}
+
+		void push(Y sample)
+		{
+			assert(uniform_);
+			push_values(&sample.value, nullptr, 1);
+		}
+
+		void push(Y sample, X at)
+		{
+			assert(!uniform_);
+			push_values(&sample.value, &at.value, 1);
+		}
+
+		[[nodiscard]] std::size_t count() const { return count_; }
+
+		[[nodiscard]] result_type value() const
+		{
+			auto total = sum_ - compensation_;
+			if constexpr (std::same_as<Rule, integration::simpson_t>)
+			{
+				//An odd number of intervals leaves one interval open
+				if (count_ >= 2 && count_ % 2 == 0)
+				{
+					if (count_ == 2)
+						total += width(1, 0) * (point_[1] + point_[0]) / 2;
+					else
+						total += details::simpson_tail(width(2, 1), width(1, 0), point_[2], point_[1], point_[0]);
+				}
+			}
+			return details::make_product<Y, X>(total);
+		}
+
+	private:
+		//Width between two carried samples, indices into point_ / at_
+		type width(std::size_t from, std::size_t to) const
+		{
+			return uniform_ ? spacing_ : at_[to] - at_[from];
+		}
+
+		void push_values(const type* y, const type* x, std::size_t n)
+		{
+			if (n == 0)
+				return;
+			if constexpr (std::same_as<Rule, integration::trapezoid_t>)
+				push_trapezoid(y, x, n);
+			else
+				push_simpson(y, x, n);
+		}
+
+		//point_[0] is the last sample
+		void push_trapezoid(const type* y, const type* x, std::size_t n)
+		{
+			std::size_t i = 0;
+			if (count_ == 0)
+			{
+				point_[0] = y[0];
+				at_[0] = x ? x[0] : type{};
+				i = 1;
+			}
+
+			auto chunk = type{};
+			if (i < n)
+			{
+				if (uniform_)
+				{
+					const auto interior = details::lane_sum<type>(n - i, [y, i](std::size_t k) { return y[i + k]; });
+					chunk = spacing_ * (point_[0] / 2 + interior - y[n - 1] / 2);
+				}
+				else
+				{
+					chunk = (x[i] - at_[0]) * (point_[0] + y[i]) / 2;
+					chunk += details::lane_sum<type>(n - i - 1, [x, y, i](std::size_t k) {
+						return (x[i + k + 1] - x[i + k]) * (y[i + k + 1] + y[i + k]) / 2;
+					});
+				}
+				point_[0] = y[n - 1];
+				at_[0] = x ? x[n - 1] : type{};
+			}
+			add(chunk);
+			count_ += n;
+		}
+
+		//point_[0] is the last sample, point_[1] the one before it, point_[2] the one before that.
+		//A pair of intervals closes whenever the number of samples becomes odd.
+		void push_simpson(const type* y, const type* x, std::size_t n)
+		{
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				point_[2] = point_[1];
+				point_[1] = point_[0];
+				point_[0] = y[i];
+				at_[2] = at_[1];
+				at_[1] = at_[0];
+				at_[0] = x ? x[i] : type{};
+				++count_;
+
+				if (count_ >= 3 && count_ % 2 == 1)
+					add(details::simpson_pair(width(2, 1), width(1, 0), point_[2], point_[1], point_[0]));
+			}
+		}
+
+		//Kahan sum over chunks, long streams of small increments keep their precision
+		void add(type increment)
+		{
+			const auto corrected = increment - compensation_;
+			const auto total = sum_ + corrected;
+			compensation_ = (total - sum_) - corrected;
+			sum_ = total;
+		}
+
+		type spacing_{};
+		bool uniform_ = false;
+		std::size_t count_ = 0;
+		std::array<type, 3> point_{};
+		std::array<type, 3> at_{};
+		type sum_{};
+		type compensation_{};
+	};
+
+	//Integral of uniformly spaced samples
+	template <details::quantity_range_c R, unit_c X, details::integration_rule_c Rule = integration::trapezoid_t>
+	[[nodiscard]] auto integrate(const R& samples, X spacing, Rule rule = {})
+	{
+		auto integral = integrator<details::range_unit_t<R>, X, Rule>(spacing, rule);
+		integral.push(quantity_span<const details::range_unit_t<R>>(std::as_const(samples).values()));
+		return integral.value();
+	}
+
+	//Integral of samples taken at the timestamps `at`
+	template <details::quantity_range_c R, details::quantity_range_c S, details::integration_rule_c Rule = integration::trapezoid_t>
+	[[nodiscard]] auto integrate(const R& samples, const S& at, Rule = {})
+	{
+		using Y = details::range_unit_t<R>;
+		using X = details::range_unit_t<S>;
+		auto integral = integrator<Y, X, Rule>{};
+		integral.push(quantity_span<const Y>(std::as_const(samples).values()), quantity_span<const X>(std::as_const(at).values()));
+		return integral.value();
+	}
+
+	//Derivative of samples `Y` over `X`, second order central differences inside and one sided at the ends.
+	//Each derivative is written once the following sample is known, so output lags input by one sample.
+	template <unit_c Y, unit_c X>
+	class differentiator
+	{
+	public:
+		using type = typename Y::type;
+		using result_unit = details::derivative_unit_t<Y, X>;
+		static_assert(std::same_as<type, typename X::type>, "Samples and spacing need the same value type");
+
+		differentiator() = default;
+		explicit differentiator(X spacing) : spacing_(spacing.value), uniform_(true) {}
+
+		//Writes one derivative per sample except the newest, returns how many were written.
+		//`out` needs room for samples.size() values.
+		std::size_t push(quantity_span<const Y> samples, quantity_span<result_unit> out)
+		{
+			assert(uniform_ && out.size() >= samples.size());
+			return push_values(samples.data(), nullptr, samples.size(), out.data());
+		}
+
+		std::size_t push(quantity_span<const Y> samples, quantity_span<const X> at, quantity_span<result_unit> out)
+		{
+			assert(!uniform_ && samples.size() == at.size() && out.size() >= samples.size());
+			return push_values(samples.data(), at.data(), samples.size(), out.data());
+		}
+
+		//Derivative of the newest sample, one sided
+		[[nodiscard]] result_unit finish() const
+		{
+			assert(count_ >= 2);
+			return result_unit{ (point_[0] - point_[1]) / width(1, 0) };
+		}
+
+	private:
+		type width(std::size_t from, std::size_t to) const
+		{
+			return uniform_ ? spacing_ : at_[to] - at_[from];
+		}
+
+		std::size_t push_values(const type* y, const type* x, std::size_t n, type* __restrict out)
+		{
+			std::size_t written = 0;
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				point_[2] = point_[1];
+				point_[1] = point_[0];
+				point_[0] = y[i];
+				at_[2] = at_[1];
+				at_[1] = at_[0];
+				at_[0] = x ? x[i] : type{};
+				++count_;
+
+				if (count_ == 2)
+					out[written++] = (point_[0] - point_[1]) / width(1, 0);
+				else if (count_ > 2)
+				{
+					const auto h0 = width(2, 1);
+					const auto h1 = width(1, 0);
+					out[written++] = (h0 * h0 * point_[0] - h1 * h1 * point_[2] + (h1 * h1 - h0 * h0) * point_[1]) / (h0 * h1 * (h0 + h1));
+				}
+			}
+			return written;
+		}
+
+		type spacing_{};
+		bool uniform_ = false;
+		std::size_t count_ = 0;
+		std::array<type, 3> point_{};
+		std::array<type, 3> at_{};
+	};
+
+	template <details::quantity_range_c R, unit_c X>
+	[[nodiscard]] auto differentiate(const R& samples, X spacing)
+	{
+		using Y = details::range_unit_t<R>;
+		auto derivative = differentiator<Y, X>(spacing);
+		auto result = quantity_vector<typename differentiator<Y, X>::result_unit>(samples.size());
+		if (samples.size() < 2)
+			return result;
+		derivative.push(quantity_span<const Y>(std::as_const(samples).values()), result.span());
+		result[samples.size() - 1] = derivative.finish();
+		return result;
+	}
+
+	template <details::quantity_range_c R, details::quantity_range_c S>
+	[[nodiscard]] auto differentiate(const R& samples, const S& at)
+	{
+		using Y = details::range_unit_t<R>;
+		using X = details::range_unit_t<S>;
+		auto derivative = differentiator<Y, X>{};
+		auto result = quantity_vector<typename differentiator<Y, X>::result_unit>(samples.size());
+		if (samples.size() < 2)
+			return result;
+		derivative.push(quantity_span<const Y>(std::as_const(samples).values()), quantity_span<const X>(std::as_const(at).values()), result.span());
+		result[samples.size() - 1] = derivative.finish();
+		return result;
+	}
+}
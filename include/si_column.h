@@ -0,0 +1,376 @@
+#pragma once
+#include "si.h"
+#include "si_container.h"
+#include "si_simd.h"
+#include <array>
+#include <bit>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <expected>
+#include <filesystem>
+#include <limits>
+#include <span>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//Binary column files: a 64 byte header with the unit of the column, followed by the raw values in native byte order.
+//The header sits at the start of the mapping, so the values keep the 64 byte alignment of quantity_vector.
+namespace si
+{
+
+	namespace details
+	{
+		enum class column_value_type : std::uint8_t
+		{
+			f32 = 1, f64, i8, i16, i32, i64, u8, u16, u32, u64
+		};
+
+		template <class T>
+		consteval column_value_type column_value_type_of()
+		{
+			if constexpr (std::same_as<T, float>) return column_value_type::f32;
+			else if constexpr (std::same_as<T, double>) return column_value_type::f64;
+			else if constexpr (std::same_as<T, std::int8_t>) return column_value_type::i8;
+			else if constexpr (std::same_as<T, std::int16_t>) return column_value_type::i16;
+			else if constexpr (std::same_as<T, std::int32_t>) return column_value_type::i32;
+			else if constexpr (std::same_as<T, std::int64_t>) return column_value_type::i64;
+			else if constexpr (std::same_as<T, std::uint8_t>) return column_value_type::u8;
+			else if constexpr (std::same_as<T, std::uint16_t>) return column_value_type::u16;
+			else if constexpr (std::same_as<T, std::uint32_t>) return column_value_type::u32;
+			else if constexpr (std::same_as<T, std::uint64_t>) return column_value_type::u64;
+			else static_assert(sizeof(T) == 0, "Column values must be a fixed size integer or floating point type");
+		}
+
+		constexpr auto column_magic = std::array<char, 6>{ 'S', 'I', 'C', 'O', 'L', '\0' };
+		constexpr std::uint16_t column_version = 1;
+		constexpr std::size_t column_header_size = 64;
+
+		struct column_header
+		{
+			std::array<char, 6> magic;
+			std::uint16_t version;
+			column_value_type type;
+			std::uint8_t value_size;
+			std::uint8_t little_endian;
+			std::array<std::int8_t, 7> exponent;
+			std::array<std::byte, 6> padding;
+			std::int64_t num;
+			std::int64_t den;
+			std::int32_t exp10;
+			std::int32_t pi;
+			std::uint64_t count;
+			std::array<std::byte, 8> reserved;
+		};
+		static_assert(sizeof(column_header) == column_header_size && std::has_unique_object_representations_v<column_header>);
+
+		template <class U>
+		consteval column_header make_column_header()
+		{
+			constexpr auto d = U::Descriptor();
+			auto header = column_header{};
+			header.magic = column_magic;
+			header.version = column_version;
+			header.type = column_value_type_of<typename U::type>();
+			header.value_size = sizeof(typename U::type);
+			header.little_endian = std::endian::native == std::endian::little;
+			for (std::size_t i = 0; i < d.exponent.size(); ++i)
+			{
+				if (!d.exponent[i].is_integer() || d.exponent[i] < -128 || d.exponent[i] > 127)
+					throw "Exponent does not fit the column header";
+				header.exponent[i] = static_cast<std::int8_t>(d.exponent[i].num);
+			}
+			header.num = d.factor.num;
+			header.den = d.factor.den;
+			header.exp10 = d.factor.exp10;
+			header.pi = d.factor.pi;
+			return header;
+		}
+
+		//Read only file mapping, or a private copy on write mapping when the values have to be rescaled
+		class file_mapping
+		{
+		public:
+			file_mapping() = default;
+			file_mapping(const file_mapping&) = delete;
+			file_mapping& operator=(const file_mapping&) = delete;
+
+			file_mapping(file_mapping&& other) noexcept :
+				data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+
+			file_mapping& operator=(file_mapping&& other) noexcept
+			{
+				std::swap(data_, other.data_);
+				std::swap(size_, other.size_);
+				return *this;
+			}
+
+			~file_mapping()
+			{
+				if (!data_)
+					return;
+#if defined(_WIN32)
+				UnmapViewOfFile(data_);
+#else
+				munmap(data_, size_);
+#endif
+			}
+
+			static std::expected<file_mapping, std::errc> open(const std::filesystem::path& path, bool copy_on_write)
+			{
+				auto mapping = file_mapping{};
+#if defined(_WIN32)
+				auto file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+				if (file == INVALID_HANDLE_VALUE)
+					return std::unexpected(std::errc::no_such_file_or_directory);
+
+				auto size = LARGE_INTEGER{};
+				if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+				{
+					CloseHandle(file);
+					return std::unexpected(std::errc::invalid_argument);
+				}
+
+				auto section = CreateFileMappingW(file, nullptr, copy_on_write ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, nullptr);
+				CloseHandle(file);
+				if (!section)
+					return std::unexpected(std::errc::io_error);
+
+				mapping.data_ = MapViewOfFile(section, copy_on_write ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0);
+				CloseHandle(section);
+				if (!mapping.data_)
+					return std::unexpected(std::errc::not_enough_memory);
+				mapping.size_ = static_cast<std::size_t>(size.QuadPart);
+#else
+				const auto file = ::open(path.c_str(), O_RDONLY);
+				if (file < 0)
+					return std::unexpected(static_cast<std::errc>(errno));
+
+				struct stat status {};
+				if (fstat(file, &status) != 0 || status.st_size == 0)
+				{
+					::close(file);
+					return std::unexpected(std::errc::invalid_argument);
+				}
+
+				const auto size = static_cast<std::size_t>(status.st_size);
+				auto* data = mmap(nullptr, size, copy_on_write ? PROT_READ | PROT_WRITE : PROT_READ, MAP_PRIVATE, file, 0);
+				::close(file);
+				if (data == MAP_FAILED)
+					return std::unexpected(static_cast<std::errc>(errno));
+				mapping.data_ = data;
+				mapping.size_ = size;
+#endif
+				return mapping;
+			}
+
+			[[nodiscard]] std::byte* data() const { return static_cast<std::byte*>(data_); }
+			[[nodiscard]] std::size_t size() const { return size_; }
+
+		private:
+			void* data_ = nullptr;
+			std::size_t size_ = 0;
+		};
+
+		//Bounds of the scale in a header, far beyond any unit but small enough that ratio::as stays cheap
+		constexpr int max_column_exp10 = 36;
+		constexpr int max_column_pi = 4;
+
+		constexpr bool multiply_fits(std::intmax_t a, std::intmax_t b)
+		{
+			constexpr auto limit = std::numeric_limits<std::intmax_t>::max();
+			if (a == 0 || b == 0)
+				return true;
+			if (a < -limit || b < -limit)
+				return false;
+			return (a < 0 ? -a : a) <= limit / (b < 0 ? -b : b);
+		}
+
+		//How much ratio's normalization can grow the numerator when `n` ends up in the denominator
+		consteval std::intmax_t normalization_growth(std::intmax_t n)
+		{
+			n = n < 0 ? -n : n;
+			auto growth = std::intmax_t{ 1 };
+			for (; n % 2 == 0; n /= 2)
+				growth *= 5;
+			for (; n % 5 == 0; n /= 5)
+				growth *= 2;
+			return growth;
+		}
+
+		constexpr std::intmax_t power_of_ten(int exp10)
+		{
+			auto result = std::intmax_t{ 1 };
+			for (int i = 0; i < exp10; ++i)
+				result *= 10;
+			return result;
+		}
+
+		//Checks the header, including that its scale converts into the scale of `U` without overflow
+		template <class U>
+		std::expected<column_header, std::errc> check_column_header(std::span<const std::byte> file)
+		{
+			constexpr auto wanted = make_column_header<U>();
+
+			if (file.size() < column_header_size)
+				return std::unexpected(std::errc::invalid_argument);
+
+			auto header = column_header{};
+			std::memcpy(&header, file.data(), column_header_size);
+			if (header.magic != column_magic || header.version != column_version)
+				return std::unexpected(std::errc::invalid_argument);
+			if (header.little_endian != wanted.little_endian || header.type != wanted.type || header.value_size != wanted.value_size)
+				return std::unexpected(std::errc::not_supported);
+			if (header.exponent != wanted.exponent)
+				return std::unexpected(std::errc::argument_out_of_domain);
+			if (header.den <= 0 || header.num == 0 || header.count > (file.size() - column_header_size) / wanted.value_size)
+				return std::unexpected(std::errc::invalid_argument);
+
+			//write_column stores the canonical form of ratio, its denominator has no factors 2 and 5
+			constexpr auto target = U::Descriptor().factor;
+			if (header.den % 2 == 0 || header.den % 5 == 0
+				|| header.exp10 < -max_column_exp10 || header.exp10 > max_column_exp10 || header.pi < -max_column_pi || header.pi > max_column_pi
+				|| !multiply_fits(header.num, target.den * normalization_growth(target.num)) || !multiply_fits(header.den, target.num))
+				return std::unexpected(std::errc::invalid_argument);
+
+			//Integers are rescaled by integer_factor, which has to fit in intmax_t
+			if constexpr (std::is_integral_v<typename U::type>)
+			{
+				const auto factor = ratio{ header.num, header.den, header.exp10, header.pi } / target;
+				if (factor.exp10 <= -19 || factor.exp10 >= 19
+					|| !multiply_fits(factor.num, power_of_ten(factor.exp10)) || !multiply_fits(factor.den, power_of_ten(-factor.exp10)))
+					return std::unexpected(std::errc::invalid_argument);
+			}
+			return header;
+		}
+
+		template <class T>
+		void rescale_values(T* values, std::size_t n, ratio factor)
+		{
+			if constexpr (std::is_floating_point_v<T>)
+				simd::scale(values, values, n, factor.template as<T>());
+			else
+			{
+				//Same exact arithmetic as integer_rescale, with the factor known only at runtime
+				using wide = std::conditional_t<std::is_signed_v<T>, std::intmax_t, std::uintmax_t>;
+				const auto r = integer_factor(factor);
+				for (std::size_t i = 0; i < n; ++i)
+					values[i] = static_cast<T>(static_cast<wide>(values[i]) * static_cast<wide>(r.multiplier) / static_cast<wide>(r.divisor));
+			}
+		}
+	}
+
+	//A column file mapped into memory and seen as values of `Unit`
+	template <unit_c Unit>
+	class mapped_column
+	{
+	public:
+		using unit_type = Unit;
+		using type = typename Unit::type;
+
+		static consteval auto Descriptor()
+		{
+			return Unit::Descriptor();
+		}
+
+		[[nodiscard]] std::size_t size() const { return size_; }
+		[[nodiscard]] bool empty() const { return size_ == 0; }
+		[[nodiscard]] const type* data() const { return reinterpret_cast<const type*>(mapping_.data() + details::column_header_size); }
+		[[nodiscard]] std::span<const type> values() const { return { data(), size_ }; }
+		[[nodiscard]] quantity_span<const Unit> span() const { return quantity_span<const Unit>{ data(), size_ }; }
+		operator quantity_span<const Unit>() const { return span(); }
+
+		//True when the file was written in another scale and the mapping holds rescaled private pages
+		[[nodiscard]] bool converted() const { return converted_; }
+
+	private:
+		mapped_column() = default;
+
+		template <unit_c U>
+		friend std::expected<mapped_column<U>, std::errc> open_column(const std::filesystem::path& path);
+
+		details::file_mapping mapping_;
+		std::size_t size_ = 0;
+		bool converted_ = false;
+	};
+
+	//Maps a column file written by write_column. The header is checked once here: other exponents fail with
+	//std::errc::argument_out_of_domain, another value type with std::errc::not_supported, a damaged file with
+	//std::errc::invalid_argument. Values in another scale of the same unit are rescaled into private pages,
+	//otherwise the values are used in place without a copy.
+	template <unit_c U>
+	std::expected<mapped_column<U>, std::errc> open_column(const std::filesystem::path& path)
+	{
+		auto header_mapping = details::file_mapping::open(path, false);
+		if (!header_mapping)
+			return std::unexpected(header_mapping.error());
+
+		const auto header = details::check_column_header<U>({ header_mapping->data(), header_mapping->size() });
+		if (!header)
+			return std::unexpected(header.error());
+
+		const auto factor = details::ratio{ header->num, header->den, header->exp10, header->pi } / U::Descriptor().factor;
+		auto column = mapped_column<U>{};
+		column.size_ = static_cast<std::size_t>(header->count);
+		column.converted_ = factor != details::ratio{};
+		if (column.converted_ && std::is_integral_v<typename U::type> && factor.pi != 0)
+			return std::unexpected(std::errc::not_supported);
+
+		if (!column.converted_)
+		{
+			column.mapping_ = std::move(*header_mapping);
+			return column;
+		}
+
+		auto mapping = details::file_mapping::open(path, true);
+		if (!mapping)
+			return std::unexpected(mapping.error());
+		column.mapping_ = std::move(*mapping);
+
+		auto* values = reinterpret_cast<typename U::type*>(column.mapping_.data() + details::column_header_size);
+		details::rescale_values(values, column.size_, factor);
+		return column;
+	}
+
+	//Writes `range` as a column file with the unit of its elements
+	template <details::quantity_range_c R>
+	std::errc write_column(const std::filesystem::path& path, const R& range)
+	{
+		using U = details::range_unit_t<R>;
+
+		auto header = details::make_column_header<U>();
+		const auto values = std::as_const(range).values();
+		header.count = values.size();
+
+#if defined(_WIN32)
+		auto* file = _wfopen(path.c_str(), L"wb");
+#else
+		auto* file = std::fopen(path.c_str(), "wb");
+#endif
+		if (!file)
+			return static_cast<std::errc>(errno);
+
+		const auto written = std::fwrite(&header, sizeof(header), 1, file) == 1
+			&& std::fwrite(values.data(), sizeof(typename U::type), values.size(), file) == values.size();
+		const auto closed = std::fclose(file) == 0;
+		return written && closed ? std::errc{} : std::errc::io_error;
+	}
+}
@@ -0,0 +1,125 @@
+#pragma once
+#include "si.h"
+#include "si_container.h"
+#include "si_simd.h"
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//Quantities stored in 16 bits and computed in float. A compact_vector halves the memory traffic of a
+//quantity_vector<Unit<float>>, loads widen a batch into float and stores narrow it back with round to nearest even.
+namespace si
+{
+
+	namespace storage
+	{
+		//IEEE 754 binary16: 11 bit significand, range up to 65504
+		struct half {};
+
+		//Upper half of a binary32: 8 bit significand, the full float range
+		struct bfloat16 {};
+	}
+
+	namespace details
+	{
+		template <class Format>
+		struct storage_format;
+
+		template <>
+		struct storage_format<storage::half>
+		{
+			static constexpr std::uint16_t narrow(float value) { return simd::half_from_float(value); }
+			static constexpr float widen(std::uint16_t bits) { return simd::half_to_float(bits); }
+			static void narrow(const float* in, std::uint16_t* out, std::size_t n) { simd::narrow_half(in, out, n); }
+			static void widen(const std::uint16_t* in, float* out, std::size_t n) { simd::widen_half(in, out, n); }
+		};
+
+		template <>
+		struct storage_format<storage::bfloat16>
+		{
+			static constexpr std::uint16_t narrow(float value) { return simd::bfloat16_from_float(value); }
+			static constexpr float widen(std::uint16_t bits) { return simd::bfloat16_to_float(bits); }
+			static void narrow(const float* in, std::uint16_t* out, std::size_t n) { simd::narrow_bfloat16(in, out, n); }
+			static void widen(const std::uint16_t* in, float* out, std::size_t n) { simd::widen_bfloat16(in, out, n); }
+		};
+
+		template <class Format>
+		concept storage_format_c = requires { sizeof(storage_format<Format>); };
+	}
+
+	//Storage only buffer of `Unit` values in a 16 bit format, e.g. compact_vector<meter<float>, storage::half>.
+	//There is no arithmetic on the stored bits, load into a quantity_span<Unit>, compute and store back.
+	template <unit_c Unit, details::storage_format_c Format>
+	class compact_vector
+	{
+	public:
+		using unit_type = Unit;
+		using type = typename Unit::type;
+		using format_type = Format;
+		static_assert(std::same_as<type, float>, "Compact storage widens into float units");
+
+		static consteval auto Descriptor()
+		{
+			return Unit::Descriptor();
+		}
+
+		compact_vector() = default;
+		explicit compact_vector(std::size_t size) : bits_(size) {}
+
+		explicit compact_vector(quantity_span<const Unit> values) : bits_(values.size())
+		{
+			store(0, values);
+		}
+
+		[[nodiscard]] std::size_t size() const { return bits_.size(); }
+		[[nodiscard]] bool empty() const { return bits_.empty(); }
+		[[nodiscard]] std::uint16_t* data() { return bits_.data(); }
+		[[nodiscard]] const std::uint16_t* data() const { return bits_.data(); }
+
+		void resize(std::size_t n) { bits_.resize(n); }
+		void clear() { bits_.clear(); }
+
+		[[nodiscard]] Unit load(std::size_t i) const
+		{
+			return Unit{ details::storage_format<Format>::widen(bits_[i]) };
+		}
+
+		template <unit_c Other>
+			requires same_exponent_c<Unit::Descriptor(), Other::Descriptor()> && std::same_as<typename Other::type, type>
+		void store(std::size_t i, Other value)
+		{
+			constexpr auto factor = details::conversion_factor(Other::Descriptor(), Descriptor());
+			bits_[i] = details::storage_format<Format>::narrow(details::rescale<factor>(value.value));
+		}
+
+		//Widens out.size() values starting at `offset`
+		void load(std::size_t offset, quantity_span<Unit> out) const
+		{
+			assert(offset + out.size() <= bits_.size());
+			details::storage_format<Format>::widen(bits_.data() + offset, out.data(), out.size());
+		}
+
+		//Narrows `values` into the buffer starting at `offset`
+		void store(std::size_t offset, quantity_span<const Unit> values)
+		{
+			assert(offset + values.size() <= bits_.size());
+			details::storage_format<Format>::narrow(values.data(), bits_.data() + offset, values.size());
+		}
+
+		void push_back(Unit value)
+		{
+			bits_.push_back(details::storage_format<Format>::narrow(value.value));
+		}
+
+		[[nodiscard]] quantity_vector<Unit> widened() const
+		{
+			auto result = quantity_vector<Unit>(bits_.size());
+			load(0, result.span());
+			return result;
+		}
+
+	private:
+		std::vector<std::uint16_t> bits_;
+	};
+}
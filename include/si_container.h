@@ -0,0 +1,357 @@
+#pragma once
+#include "si.h"
+#include <cassert>
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace si
+{
+
+	namespace details
+	{
+		//Wide enough for a full AVX-512 register and a cache line
+		constexpr std::size_t simd_alignment = 64;
+
+		template <class T, std::size_t alignment = simd_alignment>
+		struct aligned_allocator
+		{
+			using value_type = T;
+
+			template <class U> struct rebind { using other = aligned_allocator<U, alignment>; };
+
+			constexpr aligned_allocator() noexcept = default;
+
+			template <class U>
+			constexpr aligned_allocator(const aligned_allocator<U, alignment>&) noexcept {}
+
+			[[nodiscard]] T* allocate(std::size_t n)
+			{
+				return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{ alignment }));
+			}
+
+			void deallocate(T* p, std::size_t) noexcept
+			{
+				::operator delete(p, std::align_val_t{ alignment });
+			}
+
+			template <class U>
+			friend constexpr bool operator==(const aligned_allocator&, const aligned_allocator<U, alignment>&) noexcept { return true; }
+		};
+
+		//Proxy returned when indexing a quantity buffer, the storage itself only holds raw T values
+		template <class Unit>
+		class quantity_reference
+		{
+		public:
+			using unit_type = std::remove_const_t<Unit>;
+			using type = typename unit_type::type;
+			using element_type = std::conditional_t<std::is_const_v<Unit>, const type, type>;
+
+			constexpr explicit quantity_reference(element_type& value) : value_(value) {}
+
+			constexpr operator unit_type() const
+			{
+				return unit_type{ value_ };
+			}
+
+			[[nodiscard]] constexpr element_type& value() const
+			{
+				return value_;
+			}
+
+			template <details::unit_descriptor d_other>
+				requires (!std::is_const_v<Unit>) && same_exponent_c<unit_type::Descriptor(), d_other>
+			constexpr const quantity_reference& operator=(unit<type, d_other> other) const
+			{
+				constexpr auto factor = details::conversion_factor(d_other, unit_type::Descriptor());
+				value_ = details::rescale<factor>(other.value);
+				return *this;
+			}
+
+			constexpr const quantity_reference& operator=(const quantity_reference& other) const
+				requires (!std::is_const_v<Unit>)
+			{
+				value_ = other.value_;
+				return *this;
+			}
+
+		private:
+			element_type& value_;
+		};
+
+		template <class Unit>
+		class quantity_iterator
+		{
+		public:
+			using iterator_concept = std::random_access_iterator_tag;
+			using value_type = std::remove_const_t<Unit>;
+			using difference_type = std::ptrdiff_t;
+			using reference = quantity_reference<Unit>;
+			using element_type = typename reference::element_type;
+
+			constexpr quantity_iterator() = default;
+			constexpr explicit quantity_iterator(element_type* ptr) : ptr_(ptr) {}
+
+			constexpr reference operator*() const { return reference{ *ptr_ }; }
+			constexpr reference operator[](difference_type n) const { return reference{ ptr_[n] }; }
+
+			constexpr quantity_iterator& operator++() { ++ptr_; return *this; }
+			constexpr quantity_iterator operator++(int) { auto old = *this; ++ptr_; return old; }
+			constexpr quantity_iterator& operator--() { --ptr_; return *this; }
+			constexpr quantity_iterator operator--(int) { auto old = *this; --ptr_; return old; }
+			constexpr quantity_iterator& operator+=(difference_type n) { ptr_ += n; return *this; }
+			constexpr quantity_iterator& operator-=(difference_type n) { ptr_ -= n; return *this; }
+
+			friend constexpr quantity_iterator operator+(quantity_iterator it, difference_type n) { return it += n; }
+			friend constexpr quantity_iterator operator+(difference_type n, quantity_iterator it) { return it += n; }
+			friend constexpr quantity_iterator operator-(quantity_iterator it, difference_type n) { return it -= n; }
+			friend constexpr difference_type operator-(quantity_iterator a, quantity_iterator b) { return a.ptr_ - b.ptr_; }
+
+			friend constexpr bool operator==(quantity_iterator a, quantity_iterator b) = default;
+			friend constexpr auto operator<=>(quantity_iterator a, quantity_iterator b) = default;
+
+		private:
+			element_type* ptr_ = nullptr;
+		};
+	}
+
+	//Non owning view of contiguous raw values that all carry the unit `Unit`
+	template <unit_c Unit>
+	class quantity_span
+	{
+	public:
+		using unit_type = std::remove_const_t<Unit>;
+		using type = typename unit_type::type;
+		using element_type = std::conditional_t<std::is_const_v<Unit>, const type, type>;
+		using reference = details::quantity_reference<Unit>;
+		using iterator = details::quantity_iterator<Unit>;
+
+		static consteval auto Descriptor()
+		{
+			return unit_type::Descriptor();
+		}
+
+		constexpr quantity_span() = default;
+		constexpr quantity_span(element_type* data, std::size_t size) : values_(data, size) {}
+		constexpr explicit quantity_span(std::span<element_type> values) : values_(values) {}
+
+		template <class Other>
+			requires std::is_const_v<Unit> && std::same_as<Other, unit_type>
+		constexpr quantity_span(quantity_span<Other> other) : values_(other.values()) {}
+
+		[[nodiscard]] constexpr std::size_t size() const { return values_.size(); }
+		[[nodiscard]] constexpr bool empty() const { return values_.empty(); }
+		[[nodiscard]] constexpr element_type* data() const { return values_.data(); }
+		[[nodiscard]] constexpr std::span<element_type> values() const { return values_; }
+
+		[[nodiscard]] constexpr reference operator[](std::size_t i) const { return reference{ values_[i] }; }
+		[[nodiscard]] constexpr iterator begin() const { return iterator{ values_.data() }; }
+		[[nodiscard]] constexpr iterator end() const { return iterator{ values_.data() + values_.size() }; }
+
+		[[nodiscard]] constexpr quantity_span subspan(std::size_t offset, std::size_t count = std::dynamic_extent) const
+		{
+			return quantity_span{ values_.subspan(offset, count) };
+		}
+
+	private:
+		std::span<element_type> values_;
+	};
+
+	//Owning, SIMD aligned buffer of raw values that all carry the unit `Unit`
+	template <unit_c Unit>
+	class quantity_vector
+	{
+	public:
+		using unit_type = Unit;
+		using type = typename Unit::type;
+		using allocator_type = details::aligned_allocator<type>;
+		using reference = details::quantity_reference<Unit>;
+		using const_reference = details::quantity_reference<const Unit>;
+		using iterator = details::quantity_iterator<Unit>;
+		using const_iterator = details::quantity_iterator<const Unit>;
+
+		static consteval auto Descriptor()
+		{
+			return Unit::Descriptor();
+		}
+
+		quantity_vector() = default;
+		explicit quantity_vector(std::size_t size) : values_(size) {}
+		quantity_vector(std::size_t size, Unit value) : values_(size, value.value) {}
+
+		quantity_vector(std::initializer_list<Unit> list)
+		{
+			values_.reserve(list.size());
+			for (auto u : list)
+				values_.push_back(u.value);
+		}
+
+		//Rescales every value from a compatible unit, e.g. kilo_meter into meter
+		template <class Other>
+			requires same_exponent_c<Unit::Descriptor(), std::remove_const_t<Other>::Descriptor()>
+		explicit quantity_vector(quantity_span<Other> other) : values_(other.size())
+		{
+			constexpr auto factor = details::conversion_factor(std::remove_const_t<Other>::Descriptor(), Descriptor());
+			auto* __restrict out = values_.data();
+			const auto* __restrict in = other.data();
+			for (std::size_t i = 0; i < values_.size(); ++i)
+				out[i] = details::rescale<factor>(in[i]);
+		}
+
+		[[nodiscard]] std::size_t size() const { return values_.size(); }
+		[[nodiscard]] bool empty() const { return values_.empty(); }
+		[[nodiscard]] type* data() { return values_.data(); }
+		[[nodiscard]] const type* data() const { return values_.data(); }
+		[[nodiscard]] std::span<type> values() { return values_; }
+		[[nodiscard]] std::span<const type> values() const { return values_; }
+
+		void reserve(std::size_t n) { values_.reserve(n); }
+		void resize(std::size_t n) { values_.resize(n); }
+		void clear() { values_.clear(); }
+
+		template <details::unit_descriptor d_other>
+			requires same_exponent_c<Unit::Descriptor(), d_other>
+		void push_back(unit<type, d_other> other)
+		{
+			constexpr auto factor = details::conversion_factor(d_other, Descriptor());
+			values_.push_back(details::rescale<factor>(other.value));
+		}
+
+		[[nodiscard]] reference operator[](std::size_t i) { return reference{ values_[i] }; }
+		[[nodiscard]] const_reference operator[](std::size_t i) const { return const_reference{ values_[i] }; }
+
+		[[nodiscard]] iterator begin() { return iterator{ values_.data() }; }
+		[[nodiscard]] iterator end() { return iterator{ values_.data() + values_.size() }; }
+		[[nodiscard]] const_iterator begin() const { return const_iterator{ values_.data() }; }
+		[[nodiscard]] const_iterator end() const { return const_iterator{ values_.data() + values_.size() }; }
+
+		[[nodiscard]] quantity_span<Unit> span() { return quantity_span<Unit>{ values_.data(), values_.size() }; }
+		[[nodiscard]] quantity_span<const Unit> span() const { return quantity_span<const Unit>{ values_.data(), values_.size() }; }
+
+		operator quantity_span<Unit>() { return span(); }
+		operator quantity_span<const Unit>() const { return span(); }
+
+	private:
+		std::vector<type, allocator_type> values_;
+	};
+
+	namespace details
+	{
+		template <class R> struct is_quantity_range : std::false_type {};
+		template <class U> struct is_quantity_range<quantity_span<U>> : std::true_type {};
+		template <class U> struct is_quantity_range<quantity_vector<U>> : std::true_type {};
+
+		template <class R>
+		concept quantity_range_c = is_quantity_range<std::remove_cvref_t<R>>::value;
+
+		template <class R>
+		using range_unit_t = typename std::remove_cvref_t<R>::unit_type;
+
+		//Scalar results of `unit * unit` (dimensionless) are stored as a plain unit so they can still live in a quantity_vector
+		template <class R, class T>
+		struct element_unit { using type = R; };
+
+		template <class T>
+		struct element_unit<T, T> { using type = unit<T, unit_descriptor{ .exponent = {}, .factor = 1 }>; };
+
+		//The raw result of `a * b` as the type the scalar operator returns, plain T for dimensionless products
+		template <class A, class B, class T>
+		constexpr auto make_product(T value)
+		{
+			using R = decltype(std::declval<A>() * std::declval<B>());
+			if constexpr (unit_c<R>)
+				return R{ value };
+			else
+				return value;
+		}
+
+		template <class L, class R>
+		using product_unit_t = typename element_unit<decltype(std::declval<range_unit_t<L>>() * std::declval<range_unit_t<R>>()), typename range_unit_t<L>::type>::type;
+
+		template <class L, class R>
+		using quotient_unit_t = typename element_unit<decltype(std::declval<range_unit_t<L>>() / std::declval<range_unit_t<R>>()), typename range_unit_t<L>::type>::type;
+
+		template <class Out, class L, class R, class Op>
+		auto transform(const L& l, const R& r, Op op)
+		{
+			auto lhs = std::as_const(l).values();
+			auto rhs = std::as_const(r).values();
+			assert(lhs.size() == rhs.size());
+
+			auto result = quantity_vector<Out>(lhs.size());
+			auto* __restrict out = result.data();
+			const auto* __restrict a = lhs.data();
+			const auto* __restrict b = rhs.data();
+			for (std::size_t i = 0; i < lhs.size(); ++i)
+				out[i] = op(a[i], b[i]);
+			return result;
+		}
+
+		template <class Out, class R, class Op>
+		auto transform(const R& r, Op op)
+		{
+			auto in = std::as_const(r).values();
+
+			auto result = quantity_vector<Out>(in.size());
+			auto* __restrict out = result.data();
+			const auto* __restrict a = in.data();
+			for (std::size_t i = 0; i < in.size(); ++i)
+				out[i] = op(a[i]);
+			return result;
+		}
+	}
+
+	//Element wise arithmetic, follows the same rules as the scalar operators of si::unit
+
+	template <details::quantity_range_c L, details::quantity_range_c R>
+		requires same_exponent_c<details::range_unit_t<L>::Descriptor(), details::range_unit_t<R>::Descriptor()>
+	[[nodiscard]] auto operator+(const L& l, const R& r)
+	{
+		constexpr auto factor = details::conversion_factor(details::range_unit_t<R>::Descriptor(), details::range_unit_t<L>::Descriptor());
+		return details::transform<details::range_unit_t<L>>(l, r, [](auto a, auto b) { return a + details::rescale<factor>(b); });
+	}
+
+	template <details::quantity_range_c L, details::quantity_range_c R>
+		requires same_exponent_c<details::range_unit_t<L>::Descriptor(), details::range_unit_t<R>::Descriptor()>
+	[[nodiscard]] auto operator-(const L& l, const R& r)
+	{
+		constexpr auto factor = details::conversion_factor(details::range_unit_t<R>::Descriptor(), details::range_unit_t<L>::Descriptor());
+		return details::transform<details::range_unit_t<L>>(l, r, [](auto a, auto b) { return a - details::rescale<factor>(b); });
+	}
+
+	template <details::quantity_range_c L, details::quantity_range_c R>
+	[[nodiscard]] auto operator*(const L& l, const R& r)
+	{
+		return details::transform<details::product_unit_t<L, R>>(l, r, [](auto a, auto b) { return a * b; });
+	}
+
+	template <details::quantity_range_c L, details::quantity_range_c R>
+	[[nodiscard]] auto operator/(const L& l, const R& r)
+	{
+		return details::transform<details::quotient_unit_t<L, R>>(l, r, [](auto a, auto b) { return a / b; });
+	}
+
+	template <details::quantity_range_c R>
+	[[nodiscard]] auto operator*(const R& r, typename details::range_unit_t<R>::type factor)
+	{
+		return details::transform<details::range_unit_t<R>>(r, [factor](auto a) { return a * factor; });
+	}
+
+	template <details::quantity_range_c R>
+	[[nodiscard]] auto operator*(typename details::range_unit_t<R>::type factor, const R& r)
+	{
+		return r * factor;
+	}
+
+	template <details::quantity_range_c R>
+	[[nodiscard]] auto operator/(const R& r, typename details::range_unit_t<R>::type factor)
+	{
+		return details::transform<details::range_unit_t<R>>(r, [factor](auto a) { return a / factor; });
+	}
+}
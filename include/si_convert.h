@@ -0,0 +1,75 @@
+#pragma once
+#include "si.h"
+#include "si_container.h"
+#include "si_simd.h"
+#include <algorithm>
+#include <cassert>
+#include <span>
+#include <type_traits>
+
+namespace si
+{
+
+	namespace details
+	{
+		template <class T, unit_descriptor from, unit_descriptor to>
+		void convert_values(const T* in, T* out, std::size_t n)
+		{
+			constexpr auto factor = conversion_factor(from, to);
+			if constexpr (factor == ratio{})
+			{
+				if (in != out)
+					std::copy_n(in, n, out);
+			}
+			else if constexpr (std::is_floating_point_v<T>)
+			{
+				simd::scale(in, out, n, factor.template as<T>());
+			}
+			else
+			{
+				for (std::size_t i = 0; i < n; ++i)
+					out[i] = rescale<factor>(in[i]);
+			}
+		}
+
+		template <class U>
+		const typename U::type* raw_values(const U* units)
+		{
+			static_assert(sizeof(U) == sizeof(typename U::type) && std::is_standard_layout_v<U>, "Unit must be a plain wrapper of its value");
+			return &units->value;
+		}
+
+		template <class U>
+		typename U::type* raw_values(U* units)
+		{
+			static_assert(sizeof(U) == sizeof(typename U::type) && std::is_standard_layout_v<U>, "Unit must be a plain wrapper of its value");
+			return &units->value;
+		}
+	}
+
+	//Bulk rescaling of every value of `from` into `to`, both spans need the same size
+	template <unit_c To, unit_c From>
+		requires same_exponent_c<From::Descriptor(), To::Descriptor()> && std::same_as<typename From::type, typename To::type>
+	void convert(std::span<const From> from, std::span<To> to)
+	{
+		assert(from.size() == to.size());
+		details::convert_values<typename To::type, From::Descriptor(), To::Descriptor()>(details::raw_values(from.data()), details::raw_values(to.data()), from.size());
+	}
+
+	template <unit_c To, class From>
+		requires same_exponent_c<std::remove_const_t<From>::Descriptor(), To::Descriptor()> && std::same_as<typename std::remove_const_t<From>::type, typename To::type>
+	void convert(quantity_span<From> from, quantity_span<To> to)
+	{
+		assert(from.size() == to.size());
+		details::convert_values<typename To::type, std::remove_const_t<From>::Descriptor(), To::Descriptor()>(from.data(), to.data(), from.size());
+	}
+
+	//Rescales the buffer in place and returns a view of it in the new unit
+	template <unit_c To, unit_c From>
+		requires same_exponent_c<From::Descriptor(), To::Descriptor()> && std::same_as<typename From::type, typename To::type>
+	quantity_span<To> convert_in_place(quantity_span<From> values)
+	{
+		details::convert_values<typename To::type, From::Descriptor(), To::Descriptor()>(values.data(), values.data(), values.size());
+		return quantity_span<To>{ values.data(), values.size() };
+	}
+}
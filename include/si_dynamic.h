@@ -0,0 +1,230 @@
+#pragma once
+#include "si.h"
+#include "si_container.h"
+#include "si_parse.h"
+#include "si_simd.h"
+#include <bit>
+#include <cassert>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <span>
+#include <system_error>
+#include <type_traits>
+
+namespace si
+{
+
+	//A unit_descriptor in 8 bytes: seven 4 bit exponents in [-8, 7] in the low bits and the scale as a float in the high 32 bits
+	class packed_descriptor
+	{
+	public:
+		static constexpr int min_exponent = -8;
+		static constexpr int max_exponent = 7;
+
+		constexpr packed_descriptor() = default;
+
+		//Fails with std::errc::result_out_of_range when an exponent is fractional or does not fit in 4 bits
+		static constexpr std::expected<packed_descriptor, std::errc> make(const details::exponent_array& exponent, float scale)
+		{
+			std::uint64_t bits = 0;
+			for (std::size_t i = 0; i < exponent.size(); ++i)
+			{
+				if (!exponent[i].is_integer() || exponent[i] < min_exponent || exponent[i] > max_exponent)
+					return std::unexpected(std::errc::result_out_of_range);
+				bits |= static_cast<std::uint64_t>(exponent[i].num & 0xF) << (4 * i);
+			}
+			bits |= static_cast<std::uint64_t>(std::bit_cast<std::uint32_t>(scale)) << 32;
+			return packed_descriptor{ bits };
+		}
+
+		template <details::unit_descriptor d>
+		static consteval packed_descriptor of()
+		{
+			const auto packed = make(d.exponent, d.factor.template as<float>());
+			if (!packed)
+				throw "Exponents of a dynamic quantity must be integers in [-8, 7]";
+			return *packed;
+		}
+
+		[[nodiscard]] constexpr details::exponent_array exponent() const
+		{
+			auto exponent = details::exponent_array{};
+			for (std::size_t i = 0; i < exponent.size(); ++i)
+			{
+				const auto nibble = static_cast<int>((bits_ >> (4 * i)) & 0xF);
+				exponent[i] = nibble > max_exponent ? nibble - 16 : nibble;
+			}
+			return exponent;
+		}
+
+		//Factor from this scale to coherent SI units
+		[[nodiscard]] constexpr float scale() const
+		{
+			return std::bit_cast<float>(static_cast<std::uint32_t>(bits_ >> 32));
+		}
+
+		[[nodiscard]] constexpr bool same_exponent(packed_descriptor other) const
+		{
+			return ((bits_ ^ other.bits_) & exponent_mask) == 0;
+		}
+
+		[[nodiscard]] constexpr std::uint64_t bits() const { return bits_; }
+
+		friend constexpr bool operator==(packed_descriptor, packed_descriptor) = default;
+
+	private:
+		static constexpr std::uint64_t exponent_mask = 0x0FFF'FFFF;
+
+		constexpr explicit packed_descriptor(std::uint64_t bits) : bits_(bits) {}
+
+		std::uint64_t bits_ = 0;
+	};
+
+	static_assert(sizeof(packed_descriptor) == 8);
+
+	//A value whose unit is only known at runtime
+	template <class T>
+	struct dynamic_quantity
+	{
+		using type = T;
+
+		T value{};
+		packed_descriptor descriptor{};
+
+		constexpr dynamic_quantity() = default;
+		constexpr dynamic_quantity(T v, packed_descriptor d) : value(v), descriptor(d) {}
+
+		template <details::unit_descriptor d>
+		constexpr dynamic_quantity(unit<T, d> u) : value(u.value), descriptor(packed_descriptor::of<d>()) {}
+
+		//Converts into `U`, fails with std::errc::argument_out_of_domain when the exponents differ
+		template <unit_c U>
+			requires std::same_as<typename U::type, T>
+		[[nodiscard]] constexpr std::expected<U, std::errc> as() const
+		{
+			constexpr auto target = packed_descriptor::of<U::Descriptor()>();
+			if (!descriptor.same_exponent(target))
+				return std::unexpected(std::errc::argument_out_of_domain);
+			if (descriptor == target)
+				return U{ value };
+			return U{ static_cast<T>(value * (descriptor.scale() / target.scale())) };
+		}
+
+		friend constexpr bool operator==(const dynamic_quantity&, const dynamic_quantity&) = default;
+	};
+
+	//Reads a quantity written by the formatter when the unit is only known at runtime. Prefixed and derived unit symbols
+	//give the scale, e.g. 2 km is 2 with a scale of 1000, the exponent form is taken in coherent SI units with the gram as 10^-3.
+	template <class T>
+	std::from_chars_result from_chars(const char* first, const char* last, dynamic_quantity<T>& out, std::chars_format format = std::chars_format::general)
+	{
+		T value{};
+		auto result = details::parse_value(first, last, value, format);
+		if (result.ec != std::errc{})
+			return result;
+
+		details::parsed_unit unit;
+		auto tail = details::parse_unit(result.ptr, last, unit);
+		if (tail.ec != std::errc{})
+			return { first, tail.ec };
+
+		if (!unit.exp10.is_integer())
+			return { first, std::errc::invalid_argument };
+		const auto scale = details::ratio{ 1, 1, unit.exp10.num }.as<float>();
+		const auto descriptor = packed_descriptor::make(unit.exponent, scale);
+		if (!descriptor)
+			return { first, descriptor.error() };
+
+		out = dynamic_quantity<T>{ value, *descriptor };
+		return tail;
+	}
+
+	//Checks the whole batch once, then writes every value into `out` in the unit of `out`.
+	//Fails with std::errc::argument_out_of_domain, leaving `out` untouched, when any element has other exponents than `U`.
+	template <unit_c U>
+	std::errc convert(std::span<const dynamic_quantity<typename U::type>> in, quantity_span<U> out)
+	{
+		using T = typename U::type;
+		assert(in.size() == out.size());
+
+		constexpr auto target = packed_descriptor::of<U::Descriptor()>();
+		auto dimension_mismatch = false;
+		auto uniform = true;
+		const auto first = in.empty() ? target : in.front().descriptor;
+		for (const auto& q : in)
+		{
+			dimension_mismatch |= !q.descriptor.same_exponent(target);
+			uniform &= q.descriptor == first;
+		}
+		if (dimension_mismatch)
+			return std::errc::argument_out_of_domain;
+
+		auto* __restrict values = out.data();
+		for (std::size_t i = 0; i < in.size(); ++i)
+			values[i] = in[i].value;
+
+		if (uniform)
+		{
+			if (first != target)
+			{
+				if constexpr (std::is_floating_point_v<T>)
+					details::simd::scale(values, values, out.size(), static_cast<T>(first.scale() / target.scale()));
+				else
+					for (std::size_t i = 0; i < out.size(); ++i)
+						values[i] = static_cast<T>(values[i] * (first.scale() / target.scale()));
+			}
+		}
+		else
+		{
+			for (std::size_t i = 0; i < out.size(); ++i)
+				values[i] = static_cast<T>(values[i] * (in[i].descriptor.scale() / target.scale()));
+		}
+		return std::errc{};
+	}
+
+	//Finds the first of `Candidates` with the exponents of the batch, converts the batch into a
+	//quantity_vector of it and calls f with that vector. Mixed exponents, or none of the candidates,
+	//give std::errc::argument_out_of_domain and f is not called.
+	template <unit_c... Candidates, class T, class F>
+	std::errc dispatch(std::span<const dynamic_quantity<T>> in, F&& f)
+	{
+		if (in.empty())
+			return std::errc{};
+
+		const auto descriptor = in.front().descriptor;
+		auto result = std::errc::argument_out_of_domain;
+		const auto try_candidate = [&]<class U>() {
+			if (!descriptor.same_exponent(packed_descriptor::of<U::Descriptor()>()))
+				return false;
+
+			auto values = quantity_vector<U>(in.size());
+			result = si::convert(in, values.span());
+			if (result == std::errc{})
+				std::invoke(f, std::move(values));
+			return true;
+		};
+		(try_candidate.template operator()<Candidates>() || ...);
+		return result;
+	}
+}
+
+template <>
+struct std::hash<si::packed_descriptor>
+{
+	std::size_t operator()(si::packed_descriptor d) const noexcept
+	{
+		return std::hash<std::uint64_t>{}(d.bits());
+	}
+};
+
+template <class T>
+struct std::hash<si::dynamic_quantity<T>>
+{
+	std::size_t operator()(const si::dynamic_quantity<T>& q) const noexcept
+	{
+		return std::hash<T>{}(q.value) ^ (std::hash<si::packed_descriptor>{}(q.descriptor) * 31);
+	}
+};
@@ -0,0 +1,220 @@
+#pragma once
+#include "si.h"
+#include "si_container.h"
+#include <cassert>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+//Lazy arithmetic over quantity ranges. si::lazy(range) starts an expression, the usual operators
+//build a tree whose unit is derived at compile time, and si::evaluate / si::assign run the whole
+//tree as one loop without temporaries. Ranges are referenced, not copied, and must outlive the expression.
+namespace si
+{
+
+	namespace details
+	{
+		struct expression_tag {};
+
+		template <class E>
+		concept expression_c = std::derived_from<std::remove_cvref_t<E>, expression_tag>;
+
+		template <class T>
+		using dimensionless_t = unit<T, unit_descriptor{ .exponent = {}, .factor = 1 }>;
+
+		template <class Unit>
+		struct range_terminal : expression_tag
+		{
+			using unit_type = Unit;
+			using type = typename Unit::type;
+
+			const type* values;
+			std::size_t count;
+
+			[[nodiscard]] constexpr type eval(std::size_t i) const { return values[i]; }
+			[[nodiscard]] constexpr std::size_t size() const { return count; }
+		};
+
+		//A single quantity broadcast to every element
+		template <class Unit>
+		struct scalar_terminal : expression_tag
+		{
+			using unit_type = Unit;
+			using type = typename Unit::type;
+
+			type value;
+
+			[[nodiscard]] constexpr type eval(std::size_t) const { return value; }
+			[[nodiscard]] constexpr std::size_t size() const { return std::dynamic_extent; }
+		};
+
+		struct add_op
+		{
+			template <class LU, class RU> using result = LU;
+
+			template <class LU, class RU, class T>
+			static constexpr T apply(T a, T b) { return a + rescale<conversion_factor(RU::Descriptor(), LU::Descriptor())>(b); }
+		};
+
+		struct subtract_op
+		{
+			template <class LU, class RU> using result = LU;
+
+			template <class LU, class RU, class T>
+			static constexpr T apply(T a, T b) { return a - rescale<conversion_factor(RU::Descriptor(), LU::Descriptor())>(b); }
+		};
+
+		//Scale factors of * and / only change the descriptor, the raw values are combined as they are
+		struct multiply_op
+		{
+			template <class LU, class RU> using result = typename element_unit<decltype(std::declval<LU>() * std::declval<RU>()), typename LU::type>::type;
+
+			template <class LU, class RU, class T>
+			static constexpr T apply(T a, T b) { return a * b; }
+		};
+
+		struct divide_op
+		{
+			template <class LU, class RU> using result = typename element_unit<decltype(std::declval<LU>() / std::declval<RU>()), typename LU::type>::type;
+
+			template <class LU, class RU, class T>
+			static constexpr T apply(T a, T b) { return a / b; }
+		};
+
+		template <class Op, class L, class R>
+		struct binary_expression : expression_tag
+		{
+			using unit_type = typename Op::template result<typename L::unit_type, typename R::unit_type>;
+			using type = typename unit_type::type;
+
+			L lhs;
+			R rhs;
+
+			[[nodiscard]] constexpr type eval(std::size_t i) const
+			{
+				return Op::template apply<typename L::unit_type, typename R::unit_type>(lhs.eval(i), rhs.eval(i));
+			}
+
+			[[nodiscard]] constexpr std::size_t size() const
+			{
+				assert(lhs.size() == std::dynamic_extent || rhs.size() == std::dynamic_extent || lhs.size() == rhs.size());
+				return lhs.size() == std::dynamic_extent ? rhs.size() : lhs.size();
+			}
+		};
+
+		template <class X>
+		constexpr auto to_expression(const X& x)
+		{
+			if constexpr (expression_c<X>)
+				return x;
+			else if constexpr (quantity_range_c<X>)
+				return range_terminal<range_unit_t<X>>{ {}, x.values().data(), x.values().size() };
+			else
+				return scalar_terminal<X>{ {}, x.value };
+		}
+
+		template <class X>
+		concept operand_c = expression_c<X> || quantity_range_c<X> || unit_c<X>;
+
+		template <class X>
+		using operand_unit_t = typename decltype(to_expression(std::declval<X>()))::unit_type;
+
+		template <class Op, class L, class R>
+		constexpr auto make_expression(const L& l, const R& r)
+		{
+			using le = decltype(to_expression(l));
+			using re = decltype(to_expression(r));
+			return binary_expression<Op, le, re>{ {}, to_expression(l), to_expression(r) };
+		}
+	}
+
+	template <details::quantity_range_c R>
+	[[nodiscard]] constexpr auto lazy(const R& range)
+	{
+		return details::to_expression(range);
+	}
+
+	template <class L, class R>
+		requires (details::expression_c<L> || details::expression_c<R>) && details::operand_c<L> && details::operand_c<R>
+			&& same_exponent_c<details::operand_unit_t<L>::Descriptor(), details::operand_unit_t<R>::Descriptor()>
+	[[nodiscard]] constexpr auto operator+(const L& l, const R& r)
+	{
+		return details::make_expression<details::add_op>(l, r);
+	}
+
+	template <class L, class R>
+		requires (details::expression_c<L> || details::expression_c<R>) && details::operand_c<L> && details::operand_c<R>
+			&& same_exponent_c<details::operand_unit_t<L>::Descriptor(), details::operand_unit_t<R>::Descriptor()>
+	[[nodiscard]] constexpr auto operator-(const L& l, const R& r)
+	{
+		return details::make_expression<details::subtract_op>(l, r);
+	}
+
+	template <class L, class R>
+		requires (details::expression_c<L> || details::expression_c<R>) && details::operand_c<L> && details::operand_c<R>
+	[[nodiscard]] constexpr auto operator*(const L& l, const R& r)
+	{
+		return details::make_expression<details::multiply_op>(l, r);
+	}
+
+	template <class L, class R>
+		requires (details::expression_c<L> || details::expression_c<R>) && details::operand_c<L> && details::operand_c<R>
+	[[nodiscard]] constexpr auto operator/(const L& l, const R& r)
+	{
+		return details::make_expression<details::divide_op>(l, r);
+	}
+
+	template <details::expression_c E>
+	[[nodiscard]] constexpr auto operator*(const E& e, typename E::type factor)
+	{
+		return e * details::dimensionless_t<typename E::type>{ factor };
+	}
+
+	template <details::expression_c E>
+	[[nodiscard]] constexpr auto operator*(typename E::type factor, const E& e)
+	{
+		return details::dimensionless_t<typename E::type>{ factor } * e;
+	}
+
+	template <details::expression_c E>
+	[[nodiscard]] constexpr auto operator/(const E& e, typename E::type factor)
+	{
+		return e / details::dimensionless_t<typename E::type>{ factor };
+	}
+
+	template <details::expression_c E>
+	[[nodiscard]] constexpr auto operator/(typename E::type factor, const E& e)
+	{
+		return details::dimensionless_t<typename E::type>{ factor } / e;
+	}
+
+	//Runs the expression in one loop into a new buffer of its own unit
+	template <details::expression_c E>
+	[[nodiscard]] auto evaluate(const E& e)
+	{
+		assert(e.size() != std::dynamic_extent);
+
+		//A local copy of the tree cannot alias the output, its scalars stay in registers
+		const auto expression = e;
+		auto result = quantity_vector<typename E::unit_type>(expression.size());
+		auto* __restrict out = result.data();
+		for (std::size_t i = 0; i < result.size(); ++i)
+			out[i] = expression.eval(i);
+		return result;
+	}
+
+	//Runs the expression in one loop into `out`, converting to the unit of `out` on the way.
+	//Every element only reads its own index, so `out` may be one of the ranges of the expression.
+	template <unit_c U, details::expression_c E>
+		requires same_exponent_c<U::Descriptor(), E::unit_type::Descriptor()>
+	void assign(quantity_span<U> out, const E& e)
+	{
+		assert(e.size() == std::dynamic_extent || e.size() == out.size());
+
+		constexpr auto factor = details::conversion_factor(E::unit_type::Descriptor(), U::Descriptor());
+		const auto expression = e;
+		auto* values = out.data();
+		for (std::size_t i = 0; i < out.size(); ++i)
+			values[i] = details::rescale<factor>(expression.eval(i));
+	}
+}
@@ -1,52 +1,188 @@
 #pragma once
 #include "si.h"
+#include <algorithm>
+#include <array>
+#include <charconv>
 #include <format>
+#include <iterator>
+#include <string_view>
+#include <system_error>
 
 namespace si {
 
-
-	template<class T, details::unit_descriptor d, class CharT>
-	struct std::formatter<si::unit<T, d>, CharT> :
-		std::formatter<T, CharT>
+	namespace details
 	{
+		constexpr auto unit_symbols = std::array<std::string_view, 7>{"m", "s", "mol", "A", "K", "cd", "g"};
+
+		//Symbols of prefixable_units and si_prefixes, in the same order
+		constexpr auto named_unit_symbols = std::array<std::string_view, 22>{
+			"m", "s", "mol", "A", "K", "cd", "g", "Hz", "N", "Pa", "J", "W", "C", "V", "F", "\u03A9", "S", "Wb", "T", "H", "lx", "kat" };
+		constexpr auto prefix_symbols = std::array<std::string_view, 24>{
+			"q", "r", "y", "z", "a", "f", "p", "n", "\u00B5", "m", "c", "d", "da", "h", "k", "M", "G", "T", "P", "E", "Z", "Y", "R", "Q" };
+		static_assert(named_unit_symbols.size() == prefixable_units::descriptors.size() && prefix_symbols.size() == si_prefixes.size());
 
-		constexpr auto parse(auto& context)
+		template <std::size_t N, class CharT = char>
+		struct fixed_string
 		{
-			return std::formatter<T, CharT>::parse(context);
-		}
+			std::array<CharT, N> data{};
+			std::size_t size = 0;
 
+			constexpr void append(std::string_view text)
+			{
+				for (auto c : text)
+					data[size++] = c;
+			}
 
-		template<class FormatContext>
-		auto format(si::unit<T, d> u, FormatContext& fc) const
-		{
-			constexpr auto values = std::array<std::string, 7>{"m", "s", "mol", "A", "K", "cd", "g"};
+			constexpr void append(int value)
+			{
+				if (value < 0)
+					data[size++] = '-';
+				auto magnitude = value < 0 ? -static_cast<long long>(value) : static_cast<long long>(value);
+				auto digits = std::array<char, 20>{};
+				std::size_t count = 0;
+				do {
+					digits[count++] = static_cast<char>('0' + magnitude % 10);
+					magnitude /= 10;
+				} while (magnitude != 0);
+				while (count != 0)
+					data[size++] = digits[--count];
+			}
 
-			auto x = std::formatter<T, CharT>::format(u.value, fc);
+			//"2", "-1" or "1/2" for a fractional exponent
+			constexpr void append(rational value)
+			{
+				append(value.num);
+				if (!value.is_integer()) {
+					data[size++] = '/';
+					append(value.den);
+				}
+			}
+
+			[[nodiscard]] constexpr std::basic_string_view<CharT> view() const
+			{
+				return { data.data(), size };
+			}
+		};
 
-			std::string output = " ";
-			for (int i = 0; i < d.exponent.size(); ++i)
-				if (d.exponent[i] != 0) {					
-					if (d.exponent[i] == 1)
-						output += std::format("{} ", values[i]);
-					else
-						output += std::format("{}^{} ", values[i], d.exponent[i]);
+		//" km" or " GW" for a prefixed named unit, otherwise the exponents without the scale:
+		//" m A^-1" for d = m/A, " m^1/2" for a square root of meter, empty for dimensionless values.
+		//Mass is written as kg in coherent units, " m s^-2 kg" for a newton, so the text reads back in any scale.
+		template <unit_descriptor d>
+		consteval auto make_unit_suffix()
+		{
+			constexpr std::size_t mass = 6;
+			auto output = fixed_string<128>{};
+			if constexpr (constexpr auto match = find_prefix(d); match.found())
+			{
+				output.append(" ");
+				output.append(prefix_symbols[match.prefix]);
+				output.append(named_unit_symbols[match.unit]);
+				return output;
+			}
+			for (std::size_t i = 0; i < d.exponent.size(); ++i)
+				if (d.exponent[i] != 0) {
+					output.append(" ");
+					if (i == mass && d.factor == ratio{})
+						output.append("k");
+					output.append(unit_symbols[i]);
+					if (d.exponent[i] != 1) {
+						output.append("^");
+						output.append(d.exponent[i]);
+					}
 				}
-			output.pop_back();
+			return output;
+		}
+
+		template <unit_descriptor d>
+		constexpr auto unit_suffix = make_unit_suffix<d>();
+
+		//The suffix for wide formatting, the UTF-8 of µ and Ω decoded into one code point each
+		template <class CharT, unit_descriptor d>
+		consteval auto make_wide_unit_suffix()
+		{
+			constexpr auto& utf8 = unit_suffix<d>;
+			auto output = fixed_string<utf8.data.size(), CharT>{};
+			for (std::size_t i = 0; i < utf8.size;)
+			{
+				const auto lead = static_cast<unsigned char>(utf8.data[i]);
+				const std::size_t length = lead < 0x80 ? 1 : lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : 4;
+				auto code = static_cast<char32_t>(length == 1 ? lead : lead & (0x7F >> length));
+				for (std::size_t k = 1; k < length; ++k)
+					code = (code << 6) | (static_cast<unsigned char>(utf8.data[i + k]) & 0x3F);
+				output.data[output.size++] = static_cast<CharT>(code);
+				i += length;
+			}
+			return output;
+		}
 
-			std::copy(output.begin(), output.end(), x);
+		template <class CharT, unit_descriptor d>
+		constexpr auto wide_unit_suffix = make_wide_unit_suffix<CharT, d>();
 
-			return x;
+		template <class CharT, unit_descriptor d>
+		consteval std::basic_string_view<CharT> unit_suffix_for()
+		{
+			if constexpr (std::same_as<CharT, char>)
+				return unit_suffix<d>.view();
+			else
+				return wide_unit_suffix<CharT, d>.view();
 		}
-	};
 
+		//Longest shortest-roundtrip representation of a double or a 64 bit integer
+		constexpr std::size_t max_value_chars = 32;
+	}
+
+	//Same output as std::format("{}", u) without touching the heap
+	template <class T, details::unit_descriptor d, class... Format>
+	std::to_chars_result to_chars(char* first, char* last, unit<T, d> u, Format... format)
+	{
+		constexpr auto suffix = details::unit_suffix<d>.view();
+
+		auto result = std::to_chars(first, last, u.value, format...);
+		if (result.ec != std::errc{})
+			return result;
+		if (static_cast<std::size_t>(last - result.ptr) < suffix.size())
+			return { last, std::errc::value_too_large };
+		return { std::ranges::copy(suffix, result.ptr).out, std::errc{} };
+	}
+
+	//Writes at most n characters, size holds the length the full output would have
+	template <class OutputIt, class T, details::unit_descriptor d>
+	std::format_to_n_result<OutputIt> format_to_n(OutputIt out, std::iter_difference_t<OutputIt> n, unit<T, d> u)
+	{
+		constexpr auto suffix = details::unit_suffix<d>.view();
+
+		auto buffer = std::array<char, details::max_value_chars + suffix.size()>{};
+		auto result = si::to_chars(buffer.data(), buffer.data() + buffer.size(), u);
+		const auto size = static_cast<std::iter_difference_t<OutputIt>>(result.ptr - buffer.data());
+		const auto count = std::max<std::iter_difference_t<OutputIt>>(0, std::min(n, size));
+		return { std::ranges::copy_n(buffer.data(), count, out).out, size };
+	}
+
+}
+
+template<class T, si::details::unit_descriptor d, class CharT>
+struct std::formatter<si::unit<T, d>, CharT> :
+	std::formatter<T, CharT>
+{
+
+	constexpr auto parse(auto& context)
+	{
+		return std::formatter<T, CharT>::parse(context);
+	}
+
+
+	template<class FormatContext>
+	auto format(si::unit<T, d> u, FormatContext& fc) const
+	{
+		constexpr auto suffix = si::details::unit_suffix_for<CharT, d>();
 
-	template<class T, class CharT>
-		requires std::derived_from<T, typename T::base_t>
-	struct std::formatter<T, CharT> :
-		std::formatter<unit<typename T::type, T::Descriptor()>, CharT>
-	{};
+		auto out = std::formatter<T, CharT>::format(u.value, fc);
+		return std::ranges::copy(suffix, out).out;
+	}
+};
 
-	/*template<class CharT >
-	typename derived_formater<si::meter, CharT>;*/
 
-}
\ No newline at end of file
+template<si::unit_c T, class CharT>
+struct std::formatter<T, CharT> :
+	std::formatter<si::unit<typename T::type, T::Descriptor()>, CharT>
+{};
@@ -0,0 +1,238 @@
+#pragma once
+#include "si.h"
+#include "si_container.h"
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+//Small vectors and matrices of quantities. vec3 and mat3 are plain aggregates for single values,
+//vec3_soa keeps x, y and z in separate aligned buffers so one SIMD register holds one axis of several vectors.
+namespace si
+{
+	template <class T>
+	using dimensionless = unit<T, details::unit_descriptor{ .exponent = {}, .factor = 1 }>;
+
+	template <unit_c U>
+	struct vec3
+	{
+		using unit_type = U;
+		using type = typename U::type;
+
+		U x, y, z;
+	};
+
+	template <unit_c U> vec3(U, U, U) -> vec3<U>;
+
+	//Row major 3x3 matrix, every element in the unit U
+	template <unit_c U>
+	struct mat3
+	{
+		using unit_type = U;
+		using type = typename U::type;
+
+		std::array<U, 9> elements;
+
+		[[nodiscard]] constexpr U& operator()(std::size_t row, std::size_t column) { return elements[row * 3 + column]; }
+		[[nodiscard]] constexpr const U& operator()(std::size_t row, std::size_t column) const { return elements[row * 3 + column]; }
+
+		[[nodiscard]] static constexpr mat3 identity()
+		{
+			auto result = mat3{};
+			result(0, 0).value = result(1, 1).value = result(2, 2).value = type{ 1 };
+			return result;
+		}
+	};
+
+	namespace details
+	{
+		template <class A, class B>
+		using vec_product_unit_t = typename element_unit<decltype(std::declval<A>() * std::declval<B>()), typename A::type>::type;
+
+		template <class U, class T>
+		constexpr vec3<U> make_vec3(T x, T y, T z)
+		{
+			return vec3<U>{ U{ x }, U{ y }, U{ z } };
+		}
+	}
+
+	template <unit_c A, unit_c B>
+		requires same_exponent_c<A::Descriptor(), B::Descriptor()>
+	[[nodiscard]] constexpr vec3<A> operator+(vec3<A> a, vec3<B> b)
+	{
+		constexpr auto factor = details::conversion_factor(B::Descriptor(), A::Descriptor());
+		return details::make_vec3<A>(a.x.value + details::rescale<factor>(b.x.value), a.y.value + details::rescale<factor>(b.y.value), a.z.value + details::rescale<factor>(b.z.value));
+	}
+
+	template <unit_c A, unit_c B>
+		requires same_exponent_c<A::Descriptor(), B::Descriptor()>
+	[[nodiscard]] constexpr vec3<A> operator-(vec3<A> a, vec3<B> b)
+	{
+		constexpr auto factor = details::conversion_factor(B::Descriptor(), A::Descriptor());
+		return details::make_vec3<A>(a.x.value - details::rescale<factor>(b.x.value), a.y.value - details::rescale<factor>(b.y.value), a.z.value - details::rescale<factor>(b.z.value));
+	}
+
+	template <unit_c U>
+	[[nodiscard]] constexpr vec3<U> operator*(vec3<U> v, typename U::type factor)
+	{
+		return details::make_vec3<U>(v.x.value * factor, v.y.value * factor, v.z.value * factor);
+	}
+
+	template <unit_c U>
+	[[nodiscard]] constexpr vec3<U> operator*(typename U::type factor, vec3<U> v)
+	{
+		return v * factor;
+	}
+
+	//Every component times a quantity, e.g. velocity * time
+	template <unit_c U, unit_c S>
+	[[nodiscard]] constexpr auto operator*(vec3<U> v, S s)
+	{
+		return details::make_vec3<details::vec_product_unit_t<U, S>>(v.x.value * s.value, v.y.value * s.value, v.z.value * s.value);
+	}
+
+	template <unit_c S, unit_c U>
+	[[nodiscard]] constexpr auto operator*(S s, vec3<U> v)
+	{
+		return details::make_vec3<details::vec_product_unit_t<S, U>>(s.value * v.x.value, s.value * v.y.value, s.value * v.z.value);
+	}
+
+	template <unit_c U, unit_c S>
+	[[nodiscard]] constexpr auto operator/(vec3<U> v, S s)
+	{
+		using R = typename details::element_unit<decltype(std::declval<U>() / std::declval<S>()), typename U::type>::type;
+		return details::make_vec3<R>(v.x.value / s.value, v.y.value / s.value, v.z.value / s.value);
+	}
+
+	//Result unit of `a.x * b.x`, e.g. newton . meter = joule
+	template <unit_c A, unit_c B>
+	[[nodiscard]] constexpr auto dot(vec3<A> a, vec3<B> b)
+	{
+		return details::make_product<A, B>(a.x.value * b.x.value + a.y.value * b.y.value + a.z.value * b.z.value);
+	}
+
+	template <unit_c A, unit_c B>
+	[[nodiscard]] constexpr auto cross(vec3<A> a, vec3<B> b)
+	{
+		return details::make_vec3<details::vec_product_unit_t<A, B>>(
+			a.y.value * b.z.value - a.z.value * b.y.value,
+			a.z.value * b.x.value - a.x.value * b.z.value,
+			a.x.value * b.y.value - a.y.value * b.x.value);
+	}
+
+	template <unit_c U>
+	[[nodiscard]] U norm(vec3<U> v)
+	{
+		return U{ static_cast<typename U::type>(std::sqrt(v.x.value * v.x.value + v.y.value * v.y.value + v.z.value * v.z.value)) };
+	}
+
+	template <unit_c M, unit_c V>
+	[[nodiscard]] constexpr auto operator*(const mat3<M>& m, vec3<V> v)
+	{
+		const auto row = [&](std::size_t r) { return m(r, 0).value * v.x.value + m(r, 1).value * v.y.value + m(r, 2).value * v.z.value; };
+		return details::make_vec3<details::vec_product_unit_t<M, V>>(row(0), row(1), row(2));
+	}
+
+	template <unit_c A, unit_c B>
+	[[nodiscard]] constexpr auto operator*(const mat3<A>& a, const mat3<B>& b)
+	{
+		using R = details::vec_product_unit_t<A, B>;
+		auto result = mat3<R>{};
+		for (std::size_t r = 0; r < 3; ++r)
+			for (std::size_t c = 0; c < 3; ++c)
+				result(r, c).value = a(r, 0).value * b(0, c).value + a(r, 1).value * b(1, c).value + a(r, 2).value * b(2, c).value;
+		return result;
+	}
+
+	template <unit_c U>
+	[[nodiscard]] constexpr mat3<U> transpose(const mat3<U>& m)
+	{
+		auto result = mat3<U>{};
+		for (std::size_t r = 0; r < 3; ++r)
+			for (std::size_t c = 0; c < 3; ++c)
+				result(r, c) = m(c, r);
+		return result;
+	}
+
+	//Structure of arrays: n vectors with their x, y and z components in three aligned buffers
+	template <unit_c U>
+	struct vec3_soa
+	{
+		using unit_type = U;
+		using type = typename U::type;
+
+		quantity_vector<U> x, y, z;
+
+		vec3_soa() = default;
+		explicit vec3_soa(std::size_t size) : x(size), y(size), z(size) {}
+
+		[[nodiscard]] std::size_t size() const { return x.size(); }
+
+		[[nodiscard]] vec3<U> get(std::size_t i) const
+		{
+			return details::make_vec3<U>(x.values()[i], y.values()[i], z.values()[i]);
+		}
+
+		void set(std::size_t i, vec3<U> v)
+		{
+			x.values()[i] = v.x.value;
+			y.values()[i] = v.y.value;
+			z.values()[i] = v.z.value;
+		}
+	};
+
+	//Dot product of every pair of vectors, one lane per vector
+	template <unit_c A, unit_c B>
+	[[nodiscard]] auto dot(const vec3_soa<A>& a, const vec3_soa<B>& b)
+	{
+		assert(a.size() == b.size());
+		auto result = quantity_vector<details::vec_product_unit_t<A, B>>(a.size());
+
+		const auto* __restrict ax = a.x.data(); const auto* __restrict ay = a.y.data(); const auto* __restrict az = a.z.data();
+		const auto* __restrict bx = b.x.data(); const auto* __restrict by = b.y.data(); const auto* __restrict bz = b.z.data();
+		auto* __restrict out = result.data();
+		for (std::size_t i = 0; i < result.size(); ++i)
+			out[i] = ax[i] * bx[i] + ay[i] * by[i] + az[i] * bz[i];
+		return result;
+	}
+
+	template <unit_c A, unit_c B>
+	[[nodiscard]] auto cross(const vec3_soa<A>& a, const vec3_soa<B>& b)
+	{
+		assert(a.size() == b.size());
+		auto result = vec3_soa<details::vec_product_unit_t<A, B>>(a.size());
+
+		const auto* __restrict ax = a.x.data(); const auto* __restrict ay = a.y.data(); const auto* __restrict az = a.z.data();
+		const auto* __restrict bx = b.x.data(); const auto* __restrict by = b.y.data(); const auto* __restrict bz = b.z.data();
+		auto* __restrict ox = result.x.data(); auto* __restrict oy = result.y.data(); auto* __restrict oz = result.z.data();
+		for (std::size_t i = 0; i < result.size(); ++i)
+		{
+			ox[i] = ay[i] * bz[i] - az[i] * by[i];
+			oy[i] = az[i] * bx[i] - ax[i] * bz[i];
+			oz[i] = ax[i] * by[i] - ay[i] * bx[i];
+		}
+		return result;
+	}
+
+	//The same matrix applied to every vector, the matrix elements stay in registers
+	template <unit_c M, unit_c V>
+	[[nodiscard]] auto operator*(const mat3<M>& m, const vec3_soa<V>& v)
+	{
+		auto result = vec3_soa<details::vec_product_unit_t<M, V>>(v.size());
+
+		auto e = std::array<typename M::type, 9>{};
+		for (std::size_t i = 0; i < e.size(); ++i)
+			e[i] = m.elements[i].value;
+
+		const auto* __restrict vx = v.x.data(); const auto* __restrict vy = v.y.data(); const auto* __restrict vz = v.z.data();
+		auto* __restrict ox = result.x.data(); auto* __restrict oy = result.y.data(); auto* __restrict oz = result.z.data();
+		for (std::size_t i = 0; i < result.size(); ++i)
+		{
+			ox[i] = e[0] * vx[i] + e[1] * vy[i] + e[2] * vz[i];
+			oy[i] = e[3] * vx[i] + e[4] * vy[i] + e[5] * vz[i];
+			oz[i] = e[6] * vx[i] + e[7] * vy[i] + e[8] * vz[i];
+		}
+		return result;
+	}
+}
@@ -0,0 +1,297 @@
+#pragma once
+#include "si.h"
+#include <cassert>
+#include <compare>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+//Integer value types for si::unit that never touch floating point:
+//si::saturating<I> clamps on overflow, si::checked<I> remembers that an overflow happened,
+//si::fixed<I, FractionBits> is a binary fixed point number. Scale changes use the exact integer path of details::rescale.
+namespace si
+{
+
+	namespace details
+	{
+		template <std::integral I>
+		constexpr bool add_overflow(I a, I b, I& out)
+		{
+#if defined(__GNUC__) || defined(__clang__)
+			return __builtin_add_overflow(a, b, &out);
+#else
+			using limits = std::numeric_limits<I>;
+			if constexpr (std::is_signed_v<I>)
+			{
+				if ((b > 0 && a > limits::max() - b) || (b < 0 && a < limits::min() - b))
+					return true;
+			}
+			else if (a > limits::max() - b)
+				return true;
+			out = static_cast<I>(a + b);
+			return false;
+#endif
+		}
+
+		template <std::integral I>
+		constexpr bool sub_overflow(I a, I b, I& out)
+		{
+#if defined(__GNUC__) || defined(__clang__)
+			return __builtin_sub_overflow(a, b, &out);
+#else
+			using limits = std::numeric_limits<I>;
+			if constexpr (std::is_signed_v<I>)
+			{
+				if ((b < 0 && a > limits::max() + b) || (b > 0 && a < limits::min() + b))
+					return true;
+			}
+			else if (a < b)
+				return true;
+			out = static_cast<I>(a - b);
+			return false;
+#endif
+		}
+
+		template <std::integral I>
+		constexpr bool mul_overflow(I a, I b, I& out)
+		{
+#if defined(__GNUC__) || defined(__clang__)
+			return __builtin_mul_overflow(a, b, &out);
+#else
+			using limits = std::numeric_limits<I>;
+			if constexpr (std::is_signed_v<I>)
+			{
+				if (a > 0 ? (b > 0 ? a > limits::max() / b : b < limits::min() / a)
+					: (b > 0 ? a < limits::min() / b : a != 0 && b < limits::max() / a))
+					return true;
+			}
+			else if (b != 0 && a > limits::max() / b)
+				return true;
+			out = static_cast<I>(a * b);
+			return false;
+#endif
+		}
+
+		template <std::integral I>
+		constexpr bool div_overflow(I a, I b, I& out)
+		{
+			assert(b != 0);
+			if constexpr (std::is_signed_v<I>)
+				if (a == std::numeric_limits<I>::min() && b == -1)
+					return true;
+			out = static_cast<I>(a / b);
+			return false;
+		}
+
+		//integer_rescale that reports results outside of I
+		template <ratio factor, std::integral I>
+		constexpr bool rescale_overflow(I value, I& out)
+		{
+			static_assert(factor.pi == 0, "Factors of pi cannot be applied exactly to integers");
+			constexpr auto r = integer_factor(factor);
+			using wide = std::conditional_t<std::is_signed_v<I>, std::intmax_t, std::uintmax_t>;
+
+			wide product{};
+			if (mul_overflow(static_cast<wide>(value), static_cast<wide>(r.multiplier), product))
+				return true;
+			const auto result = product / static_cast<wide>(r.divisor);
+			out = static_cast<I>(result);
+			return !std::in_range<I>(result);
+		}
+
+		//Scale factors are positive, a result that overflows has the sign of the value
+		template <std::integral I>
+		constexpr I saturate_toward(bool positive)
+		{
+			return positive ? std::numeric_limits<I>::max() : std::numeric_limits<I>::min();
+		}
+	}
+
+	//Clamps to the range of I instead of wrapping
+	template <std::integral I>
+	struct saturating
+	{
+		using value_type = I;
+		I value{};
+
+		constexpr saturating() = default;
+		constexpr saturating(I v) : value(v) {}
+
+		[[nodiscard]] explicit constexpr operator I() const { return value; }
+
+		friend constexpr saturating operator+(saturating a, saturating b)
+		{
+			I out{};
+			return details::add_overflow(a.value, b.value, out) ? details::saturate_toward<I>(b.value > 0) : out;
+		}
+
+		friend constexpr saturating operator-(saturating a, saturating b)
+		{
+			I out{};
+			return details::sub_overflow(a.value, b.value, out) ? details::saturate_toward<I>(std::is_signed_v<I> && b.value < 0) : out;
+		}
+
+		friend constexpr saturating operator*(saturating a, saturating b)
+		{
+			I out{};
+			return details::mul_overflow(a.value, b.value, out) ? details::saturate_toward<I>((a.value < 0) == (b.value < 0)) : out;
+		}
+
+		friend constexpr saturating operator/(saturating a, saturating b)
+		{
+			I out{};
+			return details::div_overflow(a.value, b.value, out) ? std::numeric_limits<I>::max() : out;
+		}
+
+		constexpr saturating operator-() const { return saturating{} - *this; }
+
+		constexpr saturating& operator+=(saturating other) { return *this = *this + other; }
+		constexpr saturating& operator-=(saturating other) { return *this = *this - other; }
+		constexpr saturating& operator*=(saturating other) { return *this = *this * other; }
+		constexpr saturating& operator/=(saturating other) { return *this = *this / other; }
+
+		friend constexpr bool operator==(saturating, saturating) = default;
+		friend constexpr auto operator<=>(saturating, saturating) = default;
+
+		template <details::ratio factor>
+		[[nodiscard]] constexpr saturating scaled() const
+		{
+			I out{};
+			return details::rescale_overflow<factor>(value, out) ? details::saturate_toward<I>(value > 0) : out;
+		}
+	};
+
+	//Wraps like I, but remembers that any operation on the way overflowed
+	template <std::integral I>
+	struct checked
+	{
+		using value_type = I;
+		I value{};
+		bool overflow = false;
+
+		constexpr checked() = default;
+		constexpr checked(I v) : value(v) {}
+		constexpr checked(I v, bool overflowed) : value(v), overflow(overflowed) {}
+
+		[[nodiscard]] explicit constexpr operator I() const { return value; }
+		[[nodiscard]] constexpr bool valid() const { return !overflow; }
+
+		friend constexpr checked operator+(checked a, checked b)
+		{
+			I out{};
+			const auto overflowed = details::add_overflow(a.value, b.value, out);
+			return { out, a.overflow || b.overflow || overflowed };
+		}
+
+		friend constexpr checked operator-(checked a, checked b)
+		{
+			I out{};
+			const auto overflowed = details::sub_overflow(a.value, b.value, out);
+			return { out, a.overflow || b.overflow || overflowed };
+		}
+
+		friend constexpr checked operator*(checked a, checked b)
+		{
+			I out{};
+			const auto overflowed = details::mul_overflow(a.value, b.value, out);
+			return { out, a.overflow || b.overflow || overflowed };
+		}
+
+		friend constexpr checked operator/(checked a, checked b)
+		{
+			I out{};
+			const auto overflowed = details::div_overflow(a.value, b.value, out);
+			return { out, a.overflow || b.overflow || overflowed };
+		}
+
+		constexpr checked operator-() const { return checked{} - *this; }
+
+		constexpr checked& operator+=(checked other) { return *this = *this + other; }
+		constexpr checked& operator-=(checked other) { return *this = *this - other; }
+		constexpr checked& operator*=(checked other) { return *this = *this * other; }
+		constexpr checked& operator/=(checked other) { return *this = *this / other; }
+
+		//Compares values only, the overflow flag is not part of the number
+		friend constexpr bool operator==(checked a, checked b) { return a.value == b.value; }
+		friend constexpr auto operator<=>(checked a, checked b) { return a.value <=> b.value; }
+
+		template <details::ratio factor>
+		[[nodiscard]] constexpr checked scaled() const
+		{
+			I out{};
+			const auto overflowed = details::rescale_overflow<factor>(value, out);
+			return { out, overflow || overflowed };
+		}
+	};
+
+	//Binary fixed point, raw / 2^FractionBits. Products and quotients go through the next wider integer.
+	template <std::integral I, int FractionBits>
+	struct fixed
+	{
+		static_assert(sizeof(I) <= 4, "Products of fixed point values need an integer twice as wide");
+		static_assert(FractionBits >= 0 && FractionBits < static_cast<int>(sizeof(I) * 8));
+
+		using value_type = I;
+		using wide = std::conditional_t<std::is_signed_v<I>, std::int64_t, std::uint64_t>;
+		static constexpr int fraction_bits = FractionBits;
+
+		I raw{};
+
+		constexpr fixed() = default;
+
+		template <std::integral V>
+		constexpr fixed(V v) : raw(static_cast<I>(static_cast<wide>(v) << FractionBits)) {}
+
+		//Rounds to the nearest representable value
+		template <std::floating_point V>
+		explicit constexpr fixed(V v) : raw(static_cast<I>(v * static_cast<V>(wide{ 1 } << FractionBits) + (v < 0 ? V(-0.5) : V(0.5)))) {}
+
+		[[nodiscard]] static constexpr fixed from_raw(I raw)
+		{
+			auto result = fixed{};
+			result.raw = raw;
+			return result;
+		}
+
+		template <class V>
+		[[nodiscard]] constexpr V as() const
+		{
+			if constexpr (std::floating_point<V>)
+				return static_cast<V>(raw) / static_cast<V>(wide{ 1 } << FractionBits);
+			else
+				return static_cast<V>(raw >> FractionBits);
+		}
+
+		friend constexpr fixed operator+(fixed a, fixed b) { return from_raw(static_cast<I>(a.raw + b.raw)); }
+		friend constexpr fixed operator-(fixed a, fixed b) { return from_raw(static_cast<I>(a.raw - b.raw)); }
+
+		friend constexpr fixed operator*(fixed a, fixed b)
+		{
+			return from_raw(static_cast<I>((static_cast<wide>(a.raw) * b.raw) >> FractionBits));
+		}
+
+		friend constexpr fixed operator/(fixed a, fixed b)
+		{
+			assert(b.raw != 0);
+			return from_raw(static_cast<I>((static_cast<wide>(a.raw) << FractionBits) / b.raw));
+		}
+
+		constexpr fixed operator-() const { return from_raw(static_cast<I>(-raw)); }
+
+		constexpr fixed& operator+=(fixed other) { return *this = *this + other; }
+		constexpr fixed& operator-=(fixed other) { return *this = *this - other; }
+		constexpr fixed& operator*=(fixed other) { return *this = *this * other; }
+		constexpr fixed& operator/=(fixed other) { return *this = *this / other; }
+
+		friend constexpr bool operator==(fixed, fixed) = default;
+		friend constexpr auto operator<=>(fixed, fixed) = default;
+
+		template <details::ratio factor>
+		[[nodiscard]] constexpr fixed scaled() const
+		{
+			return from_raw(details::integer_rescale<factor>(raw));
+		}
+	};
+}
@@ -0,0 +1,390 @@
+#pragma once
+#include "si.h"
+#include "si_container.h"
+#include "si_convert.h"
+#include "si_simd.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//Math functions on quantities. The result exponents are computed at compile time, si::sqrt of SquareMeters
+//is a meter and si::pow<-1> of a second is a hertz. Roots may leave fractional exponents, e.g. m^1/2.
+namespace si
+{
+
+	namespace details
+	{
+		//r with r^n == value, or -1 when value has no integer n-th root
+		consteval std::intmax_t integer_root(std::intmax_t value, int n)
+		{
+			if (value < 0)
+				return -1;
+			std::intmax_t low = 0;
+			std::intmax_t high = value;
+			while (low <= high)
+			{
+				const auto mid = low + (high - low) / 2;
+				std::intmax_t power = 1;
+				bool above = false;
+				for (int i = 0; i < n && !above; ++i)
+				{
+					if (mid != 0 && power > value / mid)
+						above = true;
+					else
+						power *= mid;
+				}
+				if (!above && power == value)
+					return mid;
+				if (above || power > value)
+					high = mid - 1;
+				else
+					low = mid + 1;
+			}
+			return -1;
+		}
+
+		consteval ratio ratio_power(ratio base, int n)
+		{
+			auto result = ratio{};
+			const auto step = n < 0 ? ratio{} / base : base;
+			for (int i = 0; i < (n < 0 ? -n : n); ++i)
+				result = result * step;
+			return result;
+		}
+
+		consteval bool has_exact_root(ratio r, int n)
+		{
+			return r.exp10 % n == 0 && r.pi % n == 0 && integer_root(r.num, n) >= 0 && integer_root(r.den, n) >= 0;
+		}
+
+		consteval ratio ratio_root(ratio r, int n)
+		{
+			return ratio{ integer_root(r.num, n), integer_root(r.den, n), r.exp10 / n, r.pi / n };
+		}
+
+		//Factor applied to the value before raising it: none when the scale has an exact root,
+		//otherwise the value moves to coherent SI units first, e.g. sqrt of a kilo_meter gives m^1/2
+		template <unit_descriptor d, rational p>
+		consteval ratio power_input_factor()
+		{
+			return has_exact_root(ratio_power(d.factor, p.num), p.den) ? ratio{} : d.factor;
+		}
+
+		template <unit_descriptor d, rational p>
+		consteval unit_descriptor power_descriptor()
+		{
+			auto raised = ratio_power(d.factor, p.num);
+			auto factor = has_exact_root(raised, p.den) ? ratio_root(raised, p.den) : ratio{};
+			return unit_descriptor{ .exponent = d.exponent ^ p, .factor = factor };
+		}
+
+		template <class U, rational p>
+		using power_unit_t = typename element_unit<inferer_t<typename U::type, power_descriptor<U::Descriptor(), p>()>, typename U::type>::type;
+
+		template <rational p, class T>
+		constexpr T raise(T value)
+		{
+			static_assert(p.is_integer() || std::is_floating_point_v<T>, "Fractional powers need a floating point value type");
+			static_assert(p.num >= 0 || std::is_floating_point_v<T>, "Negative powers need a floating point value type");
+
+			if constexpr (p.is_integer())
+			{
+				auto result = T{ 1 };
+				for (int i = 0; i < (p.num < 0 ? -p.num : p.num); ++i)
+					result *= value;
+				return p.num < 0 ? T{ 1 } / result : result;
+			}
+			else if constexpr (p == rational{ 1, 2 })
+				return std::sqrt(value);
+			else if constexpr (p == rational{ 1, 3 })
+				return std::cbrt(value);
+			else
+				return std::pow(value, static_cast<T>(p.num) / static_cast<T>(p.den));
+		}
+
+		template <class T>
+		constexpr T fused_multiply_add(T a, T b, T c)
+		{
+			if constexpr (std::is_floating_point_v<T>)
+				return std::fma(a, b, c);
+			else
+				return a * b + c;
+		}
+
+		//Batch version: a single rounding where the target has an FMA instruction, otherwise a multiply and an add
+		//so the loop still vectorizes instead of calling the library fma per element
+		template <class T>
+		constexpr T batch_multiply_add(T a, T b, T c)
+		{
+#if defined(FP_FAST_FMA) && defined(FP_FAST_FMAF)
+			return fused_multiply_add(a, b, c);
+#else
+			return a * b + c;
+#endif
+		}
+	}
+
+	//u^(N/D). Integer powers multiply, sqrt and cbrt use std::sqrt and std::cbrt, other fractions std::pow.
+	template <int N, int D = 1, unit_c U>
+	[[nodiscard]] constexpr auto pow(U u)
+	{
+		using T = typename U::type;
+		constexpr auto p = details::rational{ N, D };
+		constexpr auto d = details::power_descriptor<U::Descriptor(), p>();
+		constexpr auto factor = details::power_input_factor<U::Descriptor(), p>();
+		return infer_cast(unit<T, d>{ details::raise<p>(details::rescale<factor>(u.value)) });
+	}
+
+	template <unit_c U>
+	[[nodiscard]] auto sqrt(U u)
+	{
+		return si::pow<1, 2>(u);
+	}
+
+	template <unit_c U>
+	[[nodiscard]] auto cbrt(U u)
+	{
+		return si::pow<1, 3>(u);
+	}
+
+	template <unit_c U>
+	[[nodiscard]] constexpr U abs(U u)
+	{
+		using T = typename U::type;
+		if constexpr (std::is_floating_point_v<T>)
+			return U{ std::abs(u.value) };
+		else
+			return U{ static_cast<T>(u.value < T{} ? -u.value : u.value) };
+	}
+
+	//In the unit of `a`, without intermediate overflow like std::hypot
+	template <unit_c A, unit_c B>
+		requires same_exponent_c<A::Descriptor(), B::Descriptor()> && std::same_as<typename A::type, typename B::type>
+	[[nodiscard]] A hypot(A a, B b)
+	{
+		constexpr auto factor = details::conversion_factor(B::Descriptor(), A::Descriptor());
+		return A{ std::hypot(a.value, details::rescale<factor>(b.value)) };
+	}
+
+	template <unit_c A, unit_c B, unit_c C>
+		requires same_exponent_c<A::Descriptor(), B::Descriptor()> && same_exponent_c<A::Descriptor(), C::Descriptor()>
+			&& std::same_as<typename A::type, typename B::type> && std::same_as<typename A::type, typename C::type>
+	[[nodiscard]] A hypot(A a, B b, C c)
+	{
+		constexpr auto factor_b = details::conversion_factor(B::Descriptor(), A::Descriptor());
+		constexpr auto factor_c = details::conversion_factor(C::Descriptor(), A::Descriptor());
+		return A{ std::hypot(a.value, details::rescale<factor_b>(b.value), details::rescale<factor_c>(c.value)) };
+	}
+
+	//a * b + c with a single rounding, `c` needs the exponents of `a * b` and is rescaled into its unit
+	template <unit_c A, unit_c B, unit_c C>
+		requires unit_c<decltype(std::declval<A>() * std::declval<B>())>
+			&& same_exponent_c<decltype(std::declval<A>() * std::declval<B>())::Descriptor(), C::Descriptor()>
+	[[nodiscard]] constexpr auto fma(A a, B b, C c)
+	{
+		using R = decltype(a * b);
+		constexpr auto factor = details::conversion_factor(C::Descriptor(), R::Descriptor());
+		return R{ details::fused_multiply_add(a.value, b.value, details::rescale<factor>(c.value)) };
+	}
+
+	template <unit_c U, unit_c L, unit_c H>
+		requires same_exponent_c<U::Descriptor(), L::Descriptor()> && same_exponent_c<U::Descriptor(), H::Descriptor()>
+	[[nodiscard]] constexpr U clamp(U u, L lower, H upper)
+	{
+		const auto lo = details::rescale<details::conversion_factor(L::Descriptor(), U::Descriptor())>(lower.value);
+		const auto hi = details::rescale<details::conversion_factor(H::Descriptor(), U::Descriptor())>(upper.value);
+		assert(!(hi < lo));
+		return U{ std::clamp(u.value, lo, hi) };
+	}
+
+	//Batch versions: `in` and `out` need the same size and may be the same buffer when the units share the value type.
+
+	template <int N, int D = 1, class From>
+	void pow(quantity_span<From> in, quantity_span<details::power_unit_t<std::remove_const_t<From>, details::rational{ N, D }>> out)
+	{
+		using U = std::remove_const_t<From>;
+		constexpr auto p = details::rational{ N, D };
+		constexpr auto factor = details::power_input_factor<U::Descriptor(), p>();
+		assert(in.size() == out.size());
+
+		const auto* a = in.data();
+		auto* o = out.data();
+		for (std::size_t i = 0; i < in.size(); ++i)
+			o[i] = details::raise<p>(details::rescale<factor>(a[i]));
+	}
+
+	//Explicit SIMD square root
+	template <class From>
+	void sqrt(quantity_span<From> in, quantity_span<details::power_unit_t<std::remove_const_t<From>, details::rational{ 1, 2 }>> out)
+	{
+		using U = std::remove_const_t<From>;
+		using T = typename U::type;
+		constexpr auto factor = details::power_input_factor<U::Descriptor(), details::rational{ 1, 2 }>();
+		assert(in.size() == out.size());
+
+		if constexpr (factor == details::ratio{})
+			details::simd::sqrt(in.data(), out.data(), in.size());
+		else
+		{
+			details::simd::scale(in.data(), out.data(), in.size(), factor.template as<T>());
+			details::simd::sqrt(out.data(), out.data(), out.size());
+		}
+	}
+
+	template <class From>
+	void cbrt(quantity_span<From> in, quantity_span<details::power_unit_t<std::remove_const_t<From>, details::rational{ 1, 3 }>> out)
+	{
+		si::pow<1, 3>(in, out);
+	}
+
+	template <class From>
+	void abs(quantity_span<From> in, quantity_span<std::remove_const_t<From>> out)
+	{
+		using T = typename std::remove_const_t<From>::type;
+		assert(in.size() == out.size());
+
+		const auto* a = in.data();
+		auto* o = out.data();
+		for (std::size_t i = 0; i < in.size(); ++i)
+			o[i] = a[i] < T{} ? -a[i] : a[i];
+	}
+
+	//Explicit SIMD sqrt(x^2 + y^2) in the unit of `x`. Unlike the scalar si::hypot it does not guard
+	//against overflow of the squares, which needs values above about 1e19 for float and 1e154 for double.
+	template <class X, class Y>
+		requires same_exponent_c<std::remove_const_t<X>::Descriptor(), std::remove_const_t<Y>::Descriptor()>
+	void hypot(quantity_span<X> x, quantity_span<Y> y, quantity_span<std::remove_const_t<X>> out)
+	{
+		using UX = std::remove_const_t<X>;
+		using UY = std::remove_const_t<Y>;
+		assert(x.size() == y.size() && x.size() == out.size());
+
+		if constexpr (details::conversion_factor(UY::Descriptor(), UX::Descriptor()) == details::ratio{})
+			details::simd::hypot(x.data(), y.data(), out.data(), x.size());
+		else
+		{
+			using T = typename UX::type;
+			//In place on `x` the converted `y` cannot go into `out` before the kernel has read `x`
+			if (static_cast<const void*>(out.data()) == static_cast<const void*>(x.data()))
+			{
+				auto converted = std::vector<T>(y.size());
+				details::convert_values<T, UY::Descriptor(), UX::Descriptor()>(y.data(), converted.data(), y.size());
+				details::simd::hypot(x.data(), converted.data(), out.data(), x.size());
+			}
+			else
+			{
+				details::convert_values<T, UY::Descriptor(), UX::Descriptor()>(y.data(), out.data(), y.size());
+				details::simd::hypot(x.data(), out.data(), out.data(), x.size());
+			}
+		}
+	}
+
+	template <class A, class B, class C>
+		requires same_exponent_c<details::product_unit_t<quantity_span<A>, quantity_span<B>>::Descriptor(), std::remove_const_t<C>::Descriptor()>
+	void fma(quantity_span<A> a, quantity_span<B> b, quantity_span<C> c, quantity_span<details::product_unit_t<quantity_span<A>, quantity_span<B>>> out)
+	{
+		using R = details::product_unit_t<quantity_span<A>, quantity_span<B>>;
+		constexpr auto factor = details::conversion_factor(std::remove_const_t<C>::Descriptor(), R::Descriptor());
+		assert(a.size() == b.size() && a.size() == c.size() && a.size() == out.size());
+
+		const auto* pa = a.data();
+		const auto* pb = b.data();
+		const auto* pc = c.data();
+		auto* o = out.data();
+		for (std::size_t i = 0; i < a.size(); ++i)
+			o[i] = details::batch_multiply_add(pa[i], pb[i], details::rescale<factor>(pc[i]));
+	}
+
+	template <class From, unit_c L, unit_c H>
+		requires same_exponent_c<std::remove_const_t<From>::Descriptor(), L::Descriptor()> && same_exponent_c<std::remove_const_t<From>::Descriptor(), H::Descriptor()>
+	void clamp(quantity_span<From> in, L lower, H upper, quantity_span<std::remove_const_t<From>> out)
+	{
+		using U = std::remove_const_t<From>;
+		const auto lo = details::rescale<details::conversion_factor(L::Descriptor(), U::Descriptor())>(lower.value);
+		const auto hi = details::rescale<details::conversion_factor(H::Descriptor(), U::Descriptor())>(upper.value);
+		assert(in.size() == out.size() && !(hi < lo));
+
+		const auto* a = in.data();
+		auto* o = out.data();
+		for (std::size_t i = 0; i < in.size(); ++i)
+			o[i] = a[i] < lo ? lo : (hi < a[i] ? hi : a[i]);
+	}
+
+	//Range versions returning a new quantity_vector
+
+	template <int N, int D = 1, details::quantity_range_c R>
+	[[nodiscard]] auto pow(const R& range)
+	{
+		using U = details::range_unit_t<R>;
+		auto in = quantity_span<const U>(std::as_const(range).values());
+		auto result = quantity_vector<details::power_unit_t<U, details::rational{ N, D }>>(in.size());
+		si::pow<N, D>(in, result.span());
+		return result;
+	}
+
+	template <details::quantity_range_c R>
+	[[nodiscard]] auto sqrt(const R& range)
+	{
+		using U = details::range_unit_t<R>;
+		auto in = quantity_span<const U>(std::as_const(range).values());
+		auto result = quantity_vector<details::power_unit_t<U, details::rational{ 1, 2 }>>(in.size());
+		si::sqrt(in, result.span());
+		return result;
+	}
+
+	template <details::quantity_range_c R>
+	[[nodiscard]] auto cbrt(const R& range)
+	{
+		return si::pow<1, 3>(range);
+	}
+
+	template <details::quantity_range_c R>
+	[[nodiscard]] auto abs(const R& range)
+	{
+		using U = details::range_unit_t<R>;
+		auto in = quantity_span<const U>(std::as_const(range).values());
+		auto result = quantity_vector<U>(in.size());
+		si::abs(in, result.span());
+		return result;
+	}
+
+	template <details::quantity_range_c X, details::quantity_range_c Y>
+		requires same_exponent_c<details::range_unit_t<X>::Descriptor(), details::range_unit_t<Y>::Descriptor()>
+	[[nodiscard]] auto hypot(const X& x, const Y& y)
+	{
+		using UX = details::range_unit_t<X>;
+		using UY = details::range_unit_t<Y>;
+		auto result = quantity_vector<UX>(x.size());
+		si::hypot(quantity_span<const UX>(std::as_const(x).values()), quantity_span<const UY>(std::as_const(y).values()), result.span());
+		return result;
+	}
+
+	template <details::quantity_range_c A, details::quantity_range_c B, details::quantity_range_c C>
+		requires same_exponent_c<details::product_unit_t<A, B>::Descriptor(), details::range_unit_t<C>::Descriptor()>
+	[[nodiscard]] auto fma(const A& a, const B& b, const C& c)
+	{
+		using UA = details::range_unit_t<A>;
+		using UB = details::range_unit_t<B>;
+		using UC = details::range_unit_t<C>;
+		auto result = quantity_vector<details::product_unit_t<A, B>>(a.size());
+		si::fma(quantity_span<const UA>(std::as_const(a).values()), quantity_span<const UB>(std::as_const(b).values()),
+			quantity_span<const UC>(std::as_const(c).values()), result.span());
+		return result;
+	}
+
+	template <details::quantity_range_c R, unit_c L, unit_c H>
+		requires same_exponent_c<details::range_unit_t<R>::Descriptor(), L::Descriptor()> && same_exponent_c<details::range_unit_t<R>::Descriptor(), H::Descriptor()>
+	[[nodiscard]] auto clamp(const R& range, L lower, H upper)
+	{
+		using U = details::range_unit_t<R>;
+		auto in = quantity_span<const U>(std::as_const(range).values());
+		auto result = quantity_vector<U>(in.size());
+		si::clamp(in, lower, upper, result.span());
+		return result;
+	}
+}
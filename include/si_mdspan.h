@@ -0,0 +1,180 @@
+#pragma once
+#include "si.h"
+#include "si_container.h"
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#if __has_include(<mdspan>)
+#include <mdspan>
+#endif
+
+//std::mdspan policies for raw buffers of quantities. quantity_accessor makes the elements `Unit` values and
+//rescales from the unit the buffer was written in on every access, nothing is copied. Strided data uses
+//std::layout_stride, layout_tiled maps blocked grids as written by many solvers.
+namespace si
+{
+
+	namespace details
+	{
+		//Proxy for an element stored in `Storage` and viewed as `Unit`, reads and writes convert on the fly
+		template <class Unit, class Storage>
+		class scaled_reference
+		{
+		public:
+			using unit_type = std::remove_const_t<Unit>;
+			using storage_type = std::remove_const_t<Storage>;
+			using type = typename unit_type::type;
+			using element_type = std::conditional_t<std::is_const_v<Storage>, const type, type>;
+
+			constexpr explicit scaled_reference(element_type& value) : value_(value) {}
+
+			constexpr operator unit_type() const
+			{
+				constexpr auto factor = conversion_factor(storage_type::Descriptor(), unit_type::Descriptor());
+				return unit_type{ rescale<factor>(value_) };
+			}
+
+			template <unit_descriptor d_other>
+				requires (!std::is_const_v<Storage>) && same_exponent_c<unit_type::Descriptor(), d_other>
+			constexpr const scaled_reference& operator=(unit<type, d_other> other) const
+			{
+				constexpr auto factor = conversion_factor(d_other, storage_type::Descriptor());
+				value_ = rescale<factor>(other.value);
+				return *this;
+			}
+
+			constexpr const scaled_reference& operator=(const scaled_reference& other) const
+				requires (!std::is_const_v<Storage>)
+			{
+				value_ = other.value_;
+				return *this;
+			}
+
+		private:
+			element_type& value_;
+		};
+	}
+
+	//AccessorPolicy over raw values written in `Storage`, seen as `Unit`. A const `Storage` gives a read only view.
+	//With the same scale the reference is the quantity_reference of quantity_span, otherwise one that rescales.
+	template <unit_c Unit, class Storage = Unit>
+		requires unit_c<std::remove_const_t<Storage>>
+			&& std::same_as<typename Unit::type, typename std::remove_const_t<Storage>::type>
+			&& same_exponent_c<Unit::Descriptor(), std::remove_const_t<Storage>::Descriptor()>
+	struct quantity_accessor
+	{
+		using element_type = std::conditional_t<std::is_const_v<Storage>, const Unit, Unit>;
+		using data_handle_type = std::conditional_t<std::is_const_v<Storage>, const typename Unit::type, typename Unit::type>*;
+		using reference = std::conditional_t<
+			details::conversion_factor(std::remove_const_t<Storage>::Descriptor(), Unit::Descriptor()) == details::ratio{},
+			details::quantity_reference<element_type>,
+			details::scaled_reference<element_type, Storage>>;
+		using offset_policy = quantity_accessor;
+
+		constexpr quantity_accessor() noexcept = default;
+
+		//A writable accessor converts to the read only one
+		template <class Other>
+			requires std::is_const_v<Storage> && std::same_as<Other, std::remove_const_t<Storage>>
+		constexpr quantity_accessor(quantity_accessor<Unit, Other>) noexcept {}
+
+		[[nodiscard]] constexpr reference access(data_handle_type p, std::size_t i) const noexcept
+		{
+			return reference{ p[i] };
+		}
+
+		[[nodiscard]] constexpr data_handle_type offset(data_handle_type p, std::size_t i) const noexcept
+		{
+			return p + i;
+		}
+	};
+
+	//LayoutMappingPolicy for grids stored in blocks of Tile... elements: the tiles in row major order,
+	//row major inside each tile. Extents that are not a multiple of the tile are padded to whole tiles.
+	template <std::size_t... Tile>
+	struct layout_tiled
+	{
+		static_assert(sizeof...(Tile) != 0 && ((Tile != 0) && ...), "Every tile extent has to be positive");
+
+		template <class Extents>
+		class mapping
+		{
+		public:
+			using extents_type = Extents;
+			using index_type = typename Extents::index_type;
+			using size_type = std::make_unsigned_t<index_type>;
+			using rank_type = typename Extents::rank_type;
+			using layout_type = layout_tiled;
+			static_assert(Extents::rank() == sizeof...(Tile), "One tile extent per dimension");
+
+			constexpr mapping() noexcept = default;
+
+			constexpr mapping(const extents_type& extents) noexcept : extents_(extents)
+			{
+				for (rank_type r = 0; r < Extents::rank(); ++r)
+					tiles_[r] = (extents_.extent(r) + static_cast<index_type>(tile[r]) - 1) / static_cast<index_type>(tile[r]);
+			}
+
+			[[nodiscard]] constexpr const extents_type& extents() const noexcept { return extents_; }
+
+			template <class... Indices>
+				requires (sizeof...(Indices) == sizeof...(Tile))
+			[[nodiscard]] constexpr index_type operator()(Indices... indices) const noexcept
+			{
+				const auto index = std::array<index_type, sizeof...(Tile)>{ static_cast<index_type>(indices)... };
+				index_type tile_index = 0;
+				index_type inner = 0;
+				for (rank_type r = 0; r < Extents::rank(); ++r)
+				{
+					const auto size = static_cast<index_type>(tile[r]);
+					tile_index = tile_index * tiles_[r] + index[r] / size;
+					inner = inner * size + index[r] % size;
+				}
+				return tile_index * static_cast<index_type>(tile_elements) + inner;
+			}
+
+			[[nodiscard]] constexpr index_type required_span_size() const noexcept
+			{
+				index_type size = static_cast<index_type>(tile_elements);
+				for (rank_type r = 0; r < Extents::rank(); ++r)
+					size *= tiles_[r];
+				return size;
+			}
+
+			[[nodiscard]] static constexpr bool is_always_unique() noexcept { return true; }
+			[[nodiscard]] static constexpr bool is_always_exhaustive() noexcept { return false; }
+			[[nodiscard]] static constexpr bool is_always_strided() noexcept { return false; }
+
+			[[nodiscard]] static constexpr bool is_unique() noexcept { return true; }
+			[[nodiscard]] static constexpr bool is_strided() noexcept { return false; }
+
+			//No padding, every extent is a multiple of its tile
+			[[nodiscard]] constexpr bool is_exhaustive() const noexcept
+			{
+				for (rank_type r = 0; r < Extents::rank(); ++r)
+					if (extents_.extent(r) % static_cast<index_type>(tile[r]) != 0)
+						return false;
+				return true;
+			}
+
+			friend constexpr bool operator==(const mapping& a, const mapping& b) noexcept
+			{
+				return a.extents_ == b.extents_;
+			}
+
+		private:
+			static constexpr auto tile = std::array<std::size_t, sizeof...(Tile)>{ Tile... };
+			static constexpr auto tile_elements = (Tile * ...);
+
+			extents_type extents_{};
+			std::array<index_type, sizeof...(Tile)> tiles_{};
+		};
+	};
+
+#ifdef __cpp_lib_mdspan
+	//Zero copy view of a raw buffer, e.g. quantity_mdspan<pascal<float>, std::dextents<std::size_t, 3>> over a solver's pressure field
+	template <unit_c Unit, class Extents, class Layout = std::layout_right, class Storage = Unit>
+	using quantity_mdspan = std::mdspan<typename quantity_accessor<Unit, Storage>::element_type, Extents, Layout, quantity_accessor<Unit, Storage>>;
+#endif
+}
@@ -0,0 +1,273 @@
+#pragma once
+#include "si.h"
+#include "si_container.h"
+#include "si_format.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <string_view>
+#include <system_error>
+
+namespace si
+{
+
+	namespace details
+	{
+		constexpr bool is_blank(char c)
+		{
+			return c == ' ' || c == '\t';
+		}
+
+		//Letters and the bytes of UTF-8 sequences, for the micro and ohm signs
+		constexpr bool is_symbol_char(char c)
+		{
+			return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || static_cast<unsigned char>(c) >= 0x80;
+		}
+
+		template <class T>
+		std::from_chars_result parse_value(const char* first, const char* last, T& value, std::chars_format format)
+		{
+			if constexpr (std::is_floating_point_v<T>)
+				return std::from_chars(first, last, value, format);
+			else
+				return std::from_chars(first, last, value);
+		}
+
+		//Applies a factor only known at runtime, exactly for integers when it fits in intmax_t
+		template <class T>
+		T rescale_by(T value, ratio factor)
+		{
+			if (factor == ratio{})
+				return value;
+			if constexpr (std::is_integral_v<T>)
+			{
+				if (factor.pi == 0 && factor.exp10 > -19 && factor.exp10 < 19)
+				{
+					const auto r = integer_factor(factor);
+					return static_cast<T>(static_cast<std::intmax_t>(value) * r.multiplier / r.divisor);
+				}
+				return static_cast<T>(static_cast<long double>(value) * factor.as<long double>());
+			}
+			else if constexpr (std::is_floating_point_v<T>)
+				return value * factor.as<T>();
+			else
+				return factor.as<float>() * value;
+		}
+
+		//Index in named_unit_symbols and the power of ten of the prefix, e.g. "kPa" or "us"
+		struct unit_symbol
+		{
+			std::size_t unit = named_unit_symbols.size();
+			int exp10 = 0;
+		};
+
+		inline unit_symbol find_symbol(std::string_view symbol)
+		{
+			const auto named = [](std::string_view text) {
+				return static_cast<std::size_t>(std::ranges::find(named_unit_symbols, text) - named_unit_symbols.begin());
+			};
+
+			//Whole symbols first, "Pa" is pascal, "mol" is mol and "T" tesla
+			if (const auto index = named(symbol); index != named_unit_symbols.size())
+				return { index, 0 };
+			for (std::size_t p = 0; p < prefix_symbols.size(); ++p)
+				if (symbol.starts_with(prefix_symbols[p]))
+					if (const auto index = named(symbol.substr(prefix_symbols[p].size())); index != named_unit_symbols.size())
+						return { index, si_prefixes[p].exp10 };
+			//ASCII spelling of micro
+			if (symbol.starts_with('u'))
+				if (const auto index = named(symbol.substr(1)); index != named_unit_symbols.size())
+					return { index, prefix::micro.exp10 };
+			return {};
+		}
+
+		//Exponents of the unit text and, when it names its scale, the power of ten to coherent SI
+		struct parsed_unit
+		{
+			exponent_array exponent{};
+			rational exp10{};
+			bool scaled = false;
+		};
+
+		//Parses the unit part written by the formatter, e.g. " m A^-1", " m^1/2" or " kPa", and returns the end of the last unit token.
+		//Text with a prefix or a derived unit name carries its scale, the bare base symbols of the exponent form do not.
+		inline std::from_chars_result parse_unit(const char* first, const char* last, parsed_unit& out)
+		{
+			out = {};
+			auto end = first;
+			auto it = first;
+			while (true)
+			{
+				while (it != last && is_blank(*it))
+					++it;
+
+				auto symbol_end = it;
+				while (symbol_end != last && is_symbol_char(*symbol_end))
+					++symbol_end;
+				if (symbol_end == it)
+				{
+					if (out.scaled && !out.exp10.is_integer())
+						return { first, std::errc::invalid_argument };
+					return { end, std::errc{} };
+				}
+
+				const auto symbol = find_symbol(std::string_view(it, symbol_end));
+				if (symbol.unit == named_unit_symbols.size())
+					return { it, std::errc::invalid_argument };
+
+				auto power = rational{ 1 };
+				it = symbol_end;
+				if (it != last && *it == '^')
+				{
+					int num = 0;
+					int den = 1;
+					auto [ptr, ec] = std::from_chars(it + 1, last, num);
+					if (ec != std::errc{})
+						return { it, std::errc::invalid_argument };
+					if (ptr != last && *ptr == '/')
+					{
+						auto [den_end, den_ec] = std::from_chars(ptr + 1, last, den);
+						if (den_ec != std::errc{} || den <= 0)
+							return { it, std::errc::invalid_argument };
+						ptr = den_end;
+					}
+					power = rational{ num, den };
+					it = ptr;
+				}
+
+				const auto& named = prefixable_units::descriptors[symbol.unit];
+				for (std::size_t i = 0; i < out.exponent.size(); ++i)
+					out.exponent[i] += named.exponent[i] * power;
+				//Every named unit is a power of ten of coherent SI, the gram 10^-3
+				out.exp10 += rational{ symbol.exp10 + named.factor.exp10 } * power;
+				out.scaled |= symbol.exp10 != 0 || symbol.unit >= unit_symbols.size();
+				end = it;
+			}
+		}
+
+		//Checks the unit text after a value against `U` and gives the factor from the text's scale to the scale of `U`
+		template <unit_c U>
+		std::from_chars_result parse_unit_of(const char* first, const char* last, ratio& factor)
+		{
+			factor = ratio{};
+
+			//Fast path, the exact text the formatter writes for this unit and nothing but blanks after it,
+			//"25 m s^-1" starts with the suffix of meter but has to be checked as a whole
+			constexpr auto suffix = unit_suffix<U::Descriptor()>.view();
+			const auto remaining = static_cast<std::size_t>(last - first);
+			const auto* end = first + suffix.size();
+			if (remaining >= suffix.size() && std::memcmp(first, suffix.data(), suffix.size()) == 0
+				&& std::all_of(end, last, is_blank))
+				return { end, std::errc{} };
+
+			parsed_unit unit;
+			auto tail = parse_unit(first, last, unit);
+			if (tail.ec != std::errc{})
+				return tail;
+			if (unit.exponent != U::Descriptor().exponent)
+				return { first, std::errc::argument_out_of_domain };
+			//The exponent form of a prefixed unit is coherent SI, "1.5 m" into km is 0.0015 km and not 1.5 km
+			constexpr auto prefixed_target = find_prefix(U::Descriptor()).found();
+			if (unit.scaled || prefixed_target)
+			{
+				if (!unit.exp10.is_integer())
+					return { first, std::errc::invalid_argument };
+				factor = ratio{ 1, 1, unit.exp10.num } / U::Descriptor().factor;
+			}
+			return tail;
+		}
+	}
+
+	//Reads a quantity in the format written by std::format("{}", u), e.g. "7.14 m A^-1" or "2.5 km".
+	//Prefixed and derived unit symbols are rescaled into `U`. The exponent form is read as coherent SI when `U` is
+	//a prefixed named unit, otherwise its value is taken in the scale of `U`. A unit with other exponents than `U` fails with std::errc::argument_out_of_domain.
+	template <unit_c U>
+	std::from_chars_result from_chars(const char* first, const char* last, U& out, std::chars_format format = std::chars_format::general)
+	{
+		typename U::type value{};
+		auto result = details::parse_value(first, last, value, format);
+		if (result.ec != std::errc{})
+			return result;
+
+		details::ratio factor;
+		auto tail = details::parse_unit_of<U>(result.ptr, last, factor);
+		if (tail.ec != std::errc{})
+			return { first, tail.ec };
+
+		out.value = details::rescale_by(value, factor);
+		return tail;
+	}
+
+	//Appends one column of delimiter separated text to `out`, one quantity per line.
+	//The unit of the first cell is checked against `U`, later cells only have to repeat its text.
+	//On failure ptr points at the offending cell and `out` holds the rows parsed so far.
+	template <unit_c U>
+	std::from_chars_result parse_column(std::string_view text, std::size_t column, quantity_vector<U>& out, char delimiter = ',', std::size_t skip_rows = 0)
+	{
+		const char* it = text.data();
+		const char* const last = text.data() + text.size();
+
+		const auto line_end = [last](const char* from) {
+			auto* newline = static_cast<const char*>(std::memchr(from, '\n', static_cast<std::size_t>(last - from)));
+			return newline ? newline : last;
+		};
+
+		auto column_checked = false;
+		auto column_suffix = std::string_view{};
+		auto column_factor = details::ratio{};
+		for (; skip_rows != 0 && it != last; --skip_rows)
+			it = std::min(line_end(it) + 1, last);
+
+		while (it != last)
+		{
+			auto* end_of_line = line_end(it);
+			auto* next_line = end_of_line == last ? last : end_of_line + 1;
+			if (end_of_line != it && *(end_of_line - 1) == '\r')
+				--end_of_line;
+			if (end_of_line == it)
+			{
+				it = next_line;
+				continue;
+			}
+
+			auto* cell = it;
+			for (std::size_t c = 0; c < column; ++c)
+			{
+				auto* separator = static_cast<const char*>(std::memchr(cell, delimiter, static_cast<std::size_t>(end_of_line - cell)));
+				if (!separator)
+					return { cell, std::errc::invalid_argument };
+				cell = separator + 1;
+			}
+
+			auto* cell_end = static_cast<const char*>(std::memchr(cell, delimiter, static_cast<std::size_t>(end_of_line - cell)));
+			cell_end = cell_end ? cell_end : end_of_line;
+
+			while (cell != cell_end && details::is_blank(*cell))
+				++cell;
+
+			while (cell_end != cell && details::is_blank(*(cell_end - 1)))
+				--cell_end;
+
+			U value{};
+			auto [value_end, value_ec] = details::parse_value(cell, cell_end, value.value, std::chars_format::general);
+			if (value_ec != std::errc{})
+				return { cell, value_ec };
+
+			if (!column_checked || std::string_view(value_end, cell_end) != column_suffix)
+			{
+				auto [ptr, ec] = details::parse_unit_of<U>(value_end, cell_end, column_factor);
+				if (ec != std::errc{})
+					return { cell, ec };
+				if (ptr != cell_end)
+					return { cell, std::errc::invalid_argument };
+				column_suffix = std::string_view(value_end, cell_end);
+				column_checked = true;
+			}
+
+			value.value = details::rescale_by(value.value, column_factor);
+			out.push_back(value);
+			it = next_line;
+		}
+		return { last, std::errc{} };
+	}
+}
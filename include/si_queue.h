@@ -0,0 +1,326 @@
+#pragma once
+#include "si.h"
+#include "si_atomic.h"
+#include "si_container.h"
+#include "si_convert.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+//Bounded lock-free queues of quantities. The ring holds raw values in the scale of Unit, producers in another
+//scale of the same dimension are converted on enqueue. Both queues move whole batches with one index update
+//and expose contiguous regions of the ring, so consumers can run batch kernels on the queue memory itself.
+namespace si
+{
+
+	namespace details
+	{
+		template <class Unit, class Other>
+		concept enqueue_c = unit_c<Other> && std::same_as<typename Other::type, typename Unit::type>
+			&& same_exponent_c<Unit::Descriptor(), Other::Descriptor()>;
+
+		//An index on its own cache line, so producer and consumer do not invalidate each other's
+		struct alignas(cache_line) padded_index
+		{
+			std::atomic<std::size_t> value{ 0 };
+			//Last seen value of the other side's index, refreshed only when it limits the region handed out
+			std::size_t cached = 0;
+		};
+
+		inline std::size_t ring_capacity(std::size_t requested)
+		{
+			assert(requested != 0);
+			return std::bit_ceil(requested);
+		}
+	}
+
+	//Single producer, single consumer. The capacity is rounded up to a power of two.
+	template <unit_c Unit>
+	class spsc_queue
+	{
+	public:
+		using unit_type = Unit;
+		using type = typename Unit::type;
+		static_assert(std::is_trivially_copyable_v<type>, "The ring stores raw values");
+
+		explicit spsc_queue(std::size_t capacity) :
+			capacity_(details::ring_capacity(capacity)), mask_(capacity_ - 1), values_(capacity_)
+		{
+		}
+
+		spsc_queue(const spsc_queue&) = delete;
+		spsc_queue& operator=(const spsc_queue&) = delete;
+
+		[[nodiscard]] std::size_t capacity() const { return capacity_; }
+
+		//Approximate while the other side is running
+		[[nodiscard]] std::size_t size() const
+		{
+			return tail_.value.load(std::memory_order_acquire) - head_.value.load(std::memory_order_acquire);
+		}
+
+		//Producer side
+
+		template <class Other>
+			requires details::enqueue_c<Unit, Other>
+		bool try_push(Other value)
+		{
+			const auto region = writable();
+			if (region.empty())
+				return false;
+			region.data()[0] = details::rescale<details::conversion_factor(Other::Descriptor(), Unit::Descriptor())>(value.value);
+			commit(1);
+			return true;
+		}
+
+		//Pushes as many values as fit, converted into the scale of Unit, and returns how many
+		template <class Other>
+			requires details::enqueue_c<Unit, std::remove_const_t<Other>>
+		std::size_t push(quantity_span<Other> values)
+		{
+			std::size_t pushed = 0;
+			//Usually one region, two when the batch wraps around the end of the ring
+			while (pushed < values.size())
+			{
+				const auto region = writable();
+				const auto n = std::min(region.size(), values.size() - pushed);
+				if (n == 0)
+					break;
+				details::convert_values<type, std::remove_const_t<Other>::Descriptor(), Unit::Descriptor()>(values.data() + pushed, region.data(), n);
+				commit(n);
+				pushed += n;
+			}
+			return pushed;
+		}
+
+		//Contiguous free slots at the tail, fill them and commit() how many were written
+		[[nodiscard]] quantity_span<Unit> writable()
+		{
+			const auto tail = tail_.value.load(std::memory_order_relaxed);
+			const auto offset = tail & mask_;
+			const auto contiguous = capacity_ - offset;
+			if (capacity_ - (tail - tail_.cached) < contiguous)
+				tail_.cached = head_.value.load(std::memory_order_acquire);
+			const auto free = capacity_ - (tail - tail_.cached);
+			return quantity_span<Unit>{ values_.data() + offset, std::min(free, contiguous) };
+		}
+
+		void commit(std::size_t n)
+		{
+			tail_.value.store(tail_.value.load(std::memory_order_relaxed) + n, std::memory_order_release);
+		}
+
+		//Consumer side
+
+		[[nodiscard]] std::optional<Unit> try_pop()
+		{
+			const auto region = readable();
+			if (region.empty())
+				return std::nullopt;
+			const auto value = Unit{ region.data()[0] };
+			consume(1);
+			return value;
+		}
+
+		//Pops up to out.size() values and returns how many
+		std::size_t pop(quantity_span<Unit> out)
+		{
+			std::size_t popped = 0;
+			while (popped < out.size())
+			{
+				const auto region = readable();
+				const auto n = std::min(region.size(), out.size() - popped);
+				if (n == 0)
+					break;
+				std::copy_n(region.data(), n, out.data() + popped);
+				consume(n);
+				popped += n;
+			}
+			return popped;
+		}
+
+		//Contiguous queued values at the head, process them in place and consume() them
+		[[nodiscard]] quantity_span<const Unit> readable()
+		{
+			const auto head = head_.value.load(std::memory_order_relaxed);
+			const auto offset = head & mask_;
+			const auto contiguous = capacity_ - offset;
+			if (head_.cached - head < contiguous)
+				head_.cached = tail_.value.load(std::memory_order_acquire);
+			const auto available = head_.cached - head;
+			return quantity_span<const Unit>{ values_.data() + offset, std::min(available, contiguous) };
+		}
+
+		void consume(std::size_t n)
+		{
+			head_.value.store(head_.value.load(std::memory_order_relaxed) + n, std::memory_order_release);
+		}
+
+	private:
+		std::size_t capacity_;
+		std::size_t mask_;
+		std::vector<type, details::aligned_allocator<type>> values_;
+		//head_.cached is the consumer's copy of the tail, tail_.cached the producer's copy of the head
+		details::padded_index head_;
+		details::padded_index tail_;
+	};
+
+	//Multiple producers, single consumer. Producers claim a contiguous range of slots with one compare and
+	//swap and publish every slot with its position, so a slow producer only holds back the values after its own.
+	template <unit_c Unit>
+	class mpsc_queue
+	{
+	public:
+		using unit_type = Unit;
+		using type = typename Unit::type;
+		static_assert(std::is_trivially_copyable_v<type>, "The ring stores raw values");
+
+		//Claimed slots, write the values and publish() them
+		class claim
+		{
+		public:
+			claim() = default;
+
+			[[nodiscard]] quantity_span<Unit> span() const { return values_; }
+			[[nodiscard]] std::size_t size() const { return values_.size(); }
+			[[nodiscard]] bool empty() const { return values_.empty(); }
+
+		private:
+			friend class mpsc_queue;
+			claim(quantity_span<Unit> values, std::size_t position) : values_(values), position_(position) {}
+
+			quantity_span<Unit> values_;
+			std::size_t position_ = 0;
+		};
+
+		explicit mpsc_queue(std::size_t capacity) :
+			capacity_(details::ring_capacity(capacity)), mask_(capacity_ - 1), values_(capacity_),
+			published_(std::make_unique<std::atomic<std::size_t>[]>(capacity_))
+		{
+		}
+
+		mpsc_queue(const mpsc_queue&) = delete;
+		mpsc_queue& operator=(const mpsc_queue&) = delete;
+
+		[[nodiscard]] std::size_t capacity() const { return capacity_; }
+
+		//Claimed slots included, published or not
+		[[nodiscard]] std::size_t size() const
+		{
+			return tail_.value.load(std::memory_order_acquire) - head_.value.load(std::memory_order_acquire);
+		}
+
+		//Producer side, from any thread
+
+		//Claims up to n contiguous slots, fewer at the end of the ring or when it is nearly full
+		[[nodiscard]] claim try_claim(std::size_t n)
+		{
+			auto tail = tail_.value.load(std::memory_order_relaxed);
+			while (true)
+			{
+				const auto free = capacity_ - (tail - head_.value.load(std::memory_order_acquire));
+				const auto offset = tail & mask_;
+				const auto count = std::min({ n, free, capacity_ - offset });
+				if (count == 0)
+					return {};
+				if (tail_.value.compare_exchange_weak(tail, tail + count, std::memory_order_relaxed))
+					return claim{ quantity_span<Unit>{ values_.data() + offset, count }, tail };
+			}
+		}
+
+		void publish(const claim& slots)
+		{
+			for (std::size_t i = 0; i < slots.size(); ++i)
+				published_[(slots.position_ + i) & mask_].store(slots.position_ + i + 1, std::memory_order_release);
+		}
+
+		template <class Other>
+			requires details::enqueue_c<Unit, Other>
+		bool try_push(Other value)
+		{
+			const auto slots = try_claim(1);
+			if (slots.empty())
+				return false;
+			slots.span().data()[0] = details::rescale<details::conversion_factor(Other::Descriptor(), Unit::Descriptor())>(value.value);
+			publish(slots);
+			return true;
+		}
+
+		template <class Other>
+			requires details::enqueue_c<Unit, std::remove_const_t<Other>>
+		std::size_t push(quantity_span<Other> values)
+		{
+			std::size_t pushed = 0;
+			while (pushed < values.size())
+			{
+				const auto slots = try_claim(values.size() - pushed);
+				if (slots.empty())
+					break;
+				details::convert_values<type, std::remove_const_t<Other>::Descriptor(), Unit::Descriptor()>(values.data() + pushed, slots.span().data(), slots.size());
+				publish(slots);
+				pushed += slots.size();
+			}
+			return pushed;
+		}
+
+		//Consumer side, one thread
+
+		[[nodiscard]] std::optional<Unit> try_pop()
+		{
+			const auto region = readable();
+			if (region.empty())
+				return std::nullopt;
+			const auto value = Unit{ region.data()[0] };
+			consume(1);
+			return value;
+		}
+
+		std::size_t pop(quantity_span<Unit> out)
+		{
+			std::size_t popped = 0;
+			while (popped < out.size())
+			{
+				const auto region = readable(out.size() - popped);
+				if (region.empty())
+					break;
+				std::copy_n(region.data(), region.size(), out.data() + popped);
+				consume(region.size());
+				popped += region.size();
+			}
+			return popped;
+		}
+
+		//Published values at the head up to the first unpublished slot or the end of the ring
+		[[nodiscard]] quantity_span<const Unit> readable(std::size_t limit = std::numeric_limits<std::size_t>::max())
+		{
+			const auto head = head_.value.load(std::memory_order_relaxed);
+			const auto offset = head & mask_;
+			const auto end = std::min(limit, capacity_ - offset);
+			std::size_t count = 0;
+			while (count < end && published_[offset + count].load(std::memory_order_acquire) == head + count + 1)
+				++count;
+			return quantity_span<const Unit>{ values_.data() + offset, count };
+		}
+
+		void consume(std::size_t n)
+		{
+			head_.value.store(head_.value.load(std::memory_order_relaxed) + n, std::memory_order_release);
+		}
+
+	private:
+		std::size_t capacity_;
+		std::size_t mask_;
+		std::vector<type, details::aligned_allocator<type>> values_;
+		//Position + 1 of the value a slot holds once it is published
+		std::unique_ptr<std::atomic<std::size_t>[]> published_;
+		details::padded_index head_;
+		details::padded_index tail_;
+	};
+}
@@ -0,0 +1,657 @@
+#pragma once
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SI_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SI_SIMD_TARGET(isa_name) __attribute__((target(isa_name)))
+#else
+#define SI_SIMD_TARGET(isa_name)
+#endif
+
+//GCC fuses a * b + c into an FMA wherever the target has one (-ffp-contract=fast in the GNU dialects), which rounds
+//differently than the separate multiply and add of SSE2 and AVX2. Clang only fuses within one expression.
+#if defined(__GNUC__) && !defined(__clang__)
+#define SI_SIMD_NO_CONTRACT __attribute__((optimize("fp-contract=off")))
+#else
+#define SI_SIMD_NO_CONTRACT
+#endif
+
+//Explicit SIMD kernels on raw values, selected once at runtime from the capabilities of the CPU
+namespace si::details::simd
+{
+	enum class isa { scalar, sse2, avx2, avx512 };
+
+	//Above this size the output is written with non temporal stores, it would only evict the input from the cache
+	constexpr std::size_t streaming_threshold = 4 * 1024 * 1024;
+
+	inline isa detect()
+	{
+#if defined(SI_SIMD_DISABLE) || !defined(SI_SIMD_X86)
+		return isa::scalar;
+#elif defined(_MSC_VER) && !defined(__clang__)
+		int info[4];
+		__cpuid(info, 0);
+		const int max_leaf = info[0];
+
+		__cpuid(info, 1);
+		const bool sse2 = (info[3] & (1 << 26)) != 0;
+		const bool os_xsave = (info[2] & (1 << 27)) != 0;
+		if (!os_xsave || max_leaf < 7)
+			return sse2 ? isa::sse2 : isa::scalar;
+
+		const auto xcr0 = _xgetbv(0);
+		__cpuidex(info, 7, 0);
+		const bool avx2 = (info[1] & (1 << 5)) != 0 && (xcr0 & 0x6) == 0x6;
+		const bool avx512 = (info[1] & (1 << 16)) != 0 && (xcr0 & 0xE6) == 0xE6;
+		return avx512 ? isa::avx512 : avx2 ? isa::avx2 : sse2 ? isa::sse2 : isa::scalar;
+#else
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx512f"))
+			return isa::avx512;
+		if (__builtin_cpu_supports("avx2"))
+			return isa::avx2;
+		if (__builtin_cpu_supports("sse2"))
+			return isa::sse2;
+		return isa::scalar;
+#endif
+	}
+
+	inline isa active_isa()
+	{
+		static const isa value = detect();
+		return value;
+	}
+
+	//Half precision conversion instructions, separate from the isa level because a few AVX2 era CPUs lack them
+	inline bool detect_f16c()
+	{
+#if defined(SI_SIMD_DISABLE) || !defined(SI_SIMD_X86)
+		return false;
+#elif defined(_MSC_VER) && !defined(__clang__)
+		int info[4];
+		__cpuid(info, 1);
+		return (info[2] & (1 << 29)) != 0 && (info[2] & (1 << 27)) != 0;
+#else
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("f16c") != 0;
+#endif
+	}
+
+	inline bool has_f16c()
+	{
+		static const bool value = detect_f16c();
+		return value;
+	}
+
+	//IEEE 754 binary16 bits, round to nearest even. NaN stays a quiet NaN, too large values become infinity.
+	constexpr std::uint16_t half_from_float(float value)
+	{
+		const auto x = std::bit_cast<std::uint32_t>(value);
+		const auto sign = static_cast<std::uint16_t>((x >> 16) & 0x8000);
+		const auto magnitude = x & 0x7FFF'FFFF;
+
+		if (magnitude >= 0x7F80'0000)
+			return static_cast<std::uint16_t>(sign | 0x7C00 | (magnitude > 0x7F80'0000 ? 0x0200 | ((magnitude >> 13) & 0x03FF) : 0));
+		if (magnitude >= 0x477F'F000)
+			return static_cast<std::uint16_t>(sign | 0x7C00);
+		if (magnitude <= 0x3300'0000)
+			return sign;
+
+		std::uint32_t bits = 0;
+		std::uint32_t rest = 0;
+		std::uint32_t halfway = 0;
+		if (magnitude < 0x3880'0000)
+		{
+			//Subnormal half, the implicit bit becomes explicit
+			const auto shift = 126 - (magnitude >> 23);
+			const auto mantissa = (magnitude & 0x007F'FFFF) | 0x0080'0000;
+			bits = mantissa >> shift;
+			rest = mantissa & ((1u << shift) - 1);
+			halfway = 1u << (shift - 1);
+		}
+		else
+		{
+			bits = (((magnitude >> 23) - 112) << 10) | ((magnitude & 0x007F'FFFF) >> 13);
+			rest = magnitude & 0x1FFF;
+			halfway = 0x1000;
+		}
+		if (rest > halfway || (rest == halfway && (bits & 1) != 0))
+			++bits;
+		return static_cast<std::uint16_t>(sign | bits);
+	}
+
+	//Signaling NaNs come back quiet like with the F16C instructions
+	constexpr float half_to_float(std::uint16_t value)
+	{
+		const auto sign = static_cast<std::uint32_t>(value & 0x8000) << 16;
+		const auto exponent = (value >> 10) & 0x1F;
+		const auto mantissa = static_cast<std::uint32_t>(value & 0x03FF);
+
+		if (exponent == 0)
+		{
+			const auto magnitude = static_cast<float>(mantissa) * 0x1p-24f;
+			return sign != 0 ? -magnitude : magnitude;
+		}
+		if (exponent == 31)
+			return std::bit_cast<float>(sign | 0x7F80'0000 | (mantissa != 0 ? 0x0040'0000 | (mantissa << 13) : 0));
+		return std::bit_cast<float>(sign | (static_cast<std::uint32_t>(exponent + 112) << 23) | (mantissa << 13));
+	}
+
+	//Upper half of a binary32, round to nearest even, NaN stays a quiet NaN
+	constexpr std::uint16_t bfloat16_from_float(float value)
+	{
+		const auto x = std::bit_cast<std::uint32_t>(value);
+		if ((x & 0x7FFF'FFFF) > 0x7F80'0000)
+			return static_cast<std::uint16_t>((x >> 16) | 0x0040);
+		return static_cast<std::uint16_t>((x + 0x7FFF + ((x >> 16) & 1)) >> 16);
+	}
+
+	constexpr float bfloat16_to_float(std::uint16_t value)
+	{
+		return std::bit_cast<float>(static_cast<std::uint32_t>(value) << 16);
+	}
+
+	template <class T>
+	inline void scale_scalar(const T* in, T* out, std::size_t n, T factor)
+	{
+		for (std::size_t i = 0; i < n; ++i)
+			out[i] = in[i] * factor;
+	}
+
+	template <class T>
+	inline void sqrt_scalar(const T* in, T* out, std::size_t n)
+	{
+		for (std::size_t i = 0; i < n; ++i)
+			out[i] = std::sqrt(in[i]);
+	}
+
+	inline void widen_half_scalar(const std::uint16_t* in, float* out, std::size_t n)
+	{
+		for (std::size_t i = 0; i < n; ++i)
+			out[i] = half_to_float(in[i]);
+	}
+
+	inline void narrow_half_scalar(const float* in, std::uint16_t* out, std::size_t n)
+	{
+		for (std::size_t i = 0; i < n; ++i)
+			out[i] = half_from_float(in[i]);
+	}
+
+	inline void widen_bfloat16_scalar(const std::uint16_t* in, float* out, std::size_t n)
+	{
+		for (std::size_t i = 0; i < n; ++i)
+			out[i] = bfloat16_to_float(in[i]);
+	}
+
+	inline void narrow_bfloat16_scalar(const float* in, std::uint16_t* out, std::size_t n)
+	{
+		for (std::size_t i = 0; i < n; ++i)
+			out[i] = bfloat16_from_float(in[i]);
+	}
+
+	//sqrt(x^2 + y^2) without the overflow guard of std::hypot and without FMA, so every ISA rounds the same way
+	template <class T>
+	SI_SIMD_NO_CONTRACT inline void hypot_scalar(const T* x, const T* y, T* out, std::size_t n)
+	{
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			const auto xx = x[i] * x[i];
+			const auto yy = y[i] * y[i];
+			out[i] = std::sqrt(xx + yy);
+		}
+	}
+
+	template <std::size_t alignment, class T>
+	inline std::size_t unaligned_head(const T* out, std::size_t n)
+	{
+		const auto misalignment = reinterpret_cast<std::uintptr_t>(out) % alignment;
+		if (misalignment == 0 || misalignment % sizeof(T) != 0)
+			return misalignment == 0 ? 0 : n;
+		const auto head = (alignment - misalignment) / sizeof(T);
+		return head < n ? head : n;
+	}
+
+#ifdef SI_SIMD_X86
+	SI_SIMD_TARGET("sse2") inline void scale_sse2(const float* in, float* out, std::size_t n, float factor)
+	{
+		std::size_t i = unaligned_head<16>(out, n);
+		scale_scalar(in, out, i, factor);
+		const bool stream = n * sizeof(float) >= streaming_threshold && in != out;
+		const auto f = _mm_set1_ps(factor);
+		if (stream)
+			for (; i + 4 <= n; i += 4)
+				_mm_stream_ps(out + i, _mm_mul_ps(_mm_loadu_ps(in + i), f));
+		for (; i + 4 <= n; i += 4)
+			_mm_store_ps(out + i, _mm_mul_ps(_mm_loadu_ps(in + i), f));
+		if (stream)
+			_mm_sfence();
+		scale_scalar(in + i, out + i, n - i, factor);
+	}
+
+	SI_SIMD_TARGET("sse2") inline void scale_sse2(const double* in, double* out, std::size_t n, double factor)
+	{
+		std::size_t i = unaligned_head<16>(out, n);
+		scale_scalar(in, out, i, factor);
+		const bool stream = n * sizeof(double) >= streaming_threshold && in != out;
+		const auto f = _mm_set1_pd(factor);
+		if (stream)
+			for (; i + 2 <= n; i += 2)
+				_mm_stream_pd(out + i, _mm_mul_pd(_mm_loadu_pd(in + i), f));
+		for (; i + 2 <= n; i += 2)
+			_mm_store_pd(out + i, _mm_mul_pd(_mm_loadu_pd(in + i), f));
+		if (stream)
+			_mm_sfence();
+		scale_scalar(in + i, out + i, n - i, factor);
+	}
+
+	SI_SIMD_TARGET("avx2") inline void scale_avx2(const float* in, float* out, std::size_t n, float factor)
+	{
+		std::size_t i = unaligned_head<32>(out, n);
+		scale_scalar(in, out, i, factor);
+		const bool stream = n * sizeof(float) >= streaming_threshold && in != out;
+		const auto f = _mm256_set1_ps(factor);
+		if (stream)
+			for (; i + 8 <= n; i += 8)
+				_mm256_stream_ps(out + i, _mm256_mul_ps(_mm256_loadu_ps(in + i), f));
+		for (; i + 8 <= n; i += 8)
+			_mm256_store_ps(out + i, _mm256_mul_ps(_mm256_loadu_ps(in + i), f));
+		if (stream)
+			_mm_sfence();
+		scale_scalar(in + i, out + i, n - i, factor);
+	}
+
+	SI_SIMD_TARGET("avx2") inline void scale_avx2(const double* in, double* out, std::size_t n, double factor)
+	{
+		std::size_t i = unaligned_head<32>(out, n);
+		scale_scalar(in, out, i, factor);
+		const bool stream = n * sizeof(double) >= streaming_threshold && in != out;
+		const auto f = _mm256_set1_pd(factor);
+		if (stream)
+			for (; i + 4 <= n; i += 4)
+				_mm256_stream_pd(out + i, _mm256_mul_pd(_mm256_loadu_pd(in + i), f));
+		for (; i + 4 <= n; i += 4)
+			_mm256_store_pd(out + i, _mm256_mul_pd(_mm256_loadu_pd(in + i), f));
+		if (stream)
+			_mm_sfence();
+		scale_scalar(in + i, out + i, n - i, factor);
+	}
+
+	SI_SIMD_TARGET("avx512f") inline void scale_avx512(const float* in, float* out, std::size_t n, float factor)
+	{
+		std::size_t i = unaligned_head<64>(out, n);
+		scale_scalar(in, out, i, factor);
+		const bool stream = n * sizeof(float) >= streaming_threshold && in != out;
+		const auto f = _mm512_set1_ps(factor);
+		if (stream)
+			for (; i + 16 <= n; i += 16)
+				_mm512_stream_ps(out + i, _mm512_mul_ps(_mm512_loadu_ps(in + i), f));
+		for (; i + 16 <= n; i += 16)
+			_mm512_store_ps(out + i, _mm512_mul_ps(_mm512_loadu_ps(in + i), f));
+		if (stream)
+			_mm_sfence();
+		const auto tail = static_cast<__mmask16>((1u << (n - i)) - 1);
+		_mm512_mask_storeu_ps(out + i, tail, _mm512_mul_ps(_mm512_maskz_loadu_ps(tail, in + i), f));
+	}
+
+	SI_SIMD_TARGET("avx512f") inline void scale_avx512(const double* in, double* out, std::size_t n, double factor)
+	{
+		std::size_t i = unaligned_head<64>(out, n);
+		scale_scalar(in, out, i, factor);
+		const bool stream = n * sizeof(double) >= streaming_threshold && in != out;
+		const auto f = _mm512_set1_pd(factor);
+		if (stream)
+			for (; i + 8 <= n; i += 8)
+				_mm512_stream_pd(out + i, _mm512_mul_pd(_mm512_loadu_pd(in + i), f));
+		for (; i + 8 <= n; i += 8)
+			_mm512_store_pd(out + i, _mm512_mul_pd(_mm512_loadu_pd(in + i), f));
+		if (stream)
+			_mm_sfence();
+		const auto tail = static_cast<__mmask8>((1u << (n - i)) - 1);
+		_mm512_mask_storeu_pd(out + i, tail, _mm512_mul_pd(_mm512_maskz_loadu_pd(tail, in + i), f));
+	}
+
+	SI_SIMD_TARGET("sse2") inline void sqrt_sse2(const float* in, float* out, std::size_t n)
+	{
+		std::size_t i = 0;
+		for (; i + 4 <= n; i += 4)
+			_mm_storeu_ps(out + i, _mm_sqrt_ps(_mm_loadu_ps(in + i)));
+		sqrt_scalar(in + i, out + i, n - i);
+	}
+
+	SI_SIMD_TARGET("sse2") inline void sqrt_sse2(const double* in, double* out, std::size_t n)
+	{
+		std::size_t i = 0;
+		for (; i + 2 <= n; i += 2)
+			_mm_storeu_pd(out + i, _mm_sqrt_pd(_mm_loadu_pd(in + i)));
+		sqrt_scalar(in + i, out + i, n - i);
+	}
+
+	SI_SIMD_TARGET("avx2") inline void sqrt_avx2(const float* in, float* out, std::size_t n)
+	{
+		std::size_t i = 0;
+		for (; i + 8 <= n; i += 8)
+			_mm256_storeu_ps(out + i, _mm256_sqrt_ps(_mm256_loadu_ps(in + i)));
+		sqrt_scalar(in + i, out + i, n - i);
+	}
+
+	SI_SIMD_TARGET("avx2") inline void sqrt_avx2(const double* in, double* out, std::size_t n)
+	{
+		std::size_t i = 0;
+		for (; i + 4 <= n; i += 4)
+			_mm256_storeu_pd(out + i, _mm256_sqrt_pd(_mm256_loadu_pd(in + i)));
+		sqrt_scalar(in + i, out + i, n - i);
+	}
+
+	SI_SIMD_TARGET("avx512f") inline void sqrt_avx512(const float* in, float* out, std::size_t n)
+	{
+		std::size_t i = 0;
+		for (; i + 16 <= n; i += 16)
+			_mm512_storeu_ps(out + i, _mm512_sqrt_ps(_mm512_loadu_ps(in + i)));
+		const auto tail = static_cast<__mmask16>((1u << (n - i)) - 1);
+		_mm512_mask_storeu_ps(out + i, tail, _mm512_sqrt_ps(_mm512_maskz_loadu_ps(tail, in + i)));
+	}
+
+	SI_SIMD_TARGET("avx512f") inline void sqrt_avx512(const double* in, double* out, std::size_t n)
+	{
+		std::size_t i = 0;
+		for (; i + 8 <= n; i += 8)
+			_mm512_storeu_pd(out + i, _mm512_sqrt_pd(_mm512_loadu_pd(in + i)));
+		const auto tail = static_cast<__mmask8>((1u << (n - i)) - 1);
+		_mm512_mask_storeu_pd(out + i, tail, _mm512_sqrt_pd(_mm512_maskz_loadu_pd(tail, in + i)));
+	}
+
+	SI_SIMD_TARGET("sse2") SI_SIMD_NO_CONTRACT inline void hypot_sse2(const float* x, const float* y, float* out, std::size_t n)
+	{
+		std::size_t i = 0;
+		for (; i + 4 <= n; i += 4)
+		{
+			const auto a = _mm_loadu_ps(x + i);
+			const auto b = _mm_loadu_ps(y + i);
+			_mm_storeu_ps(out + i, _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(a, a), _mm_mul_ps(b, b))));
+		}
+		hypot_scalar(x + i, y + i, out + i, n - i);
+	}
+
+	SI_SIMD_TARGET("sse2") SI_SIMD_NO_CONTRACT inline void hypot_sse2(const double* x, const double* y, double* out, std::size_t n)
+	{
+		std::size_t i = 0;
+		for (; i + 2 <= n; i += 2)
+		{
+			const auto a = _mm_loadu_pd(x + i);
+			const auto b = _mm_loadu_pd(y + i);
+			_mm_storeu_pd(out + i, _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(a, a), _mm_mul_pd(b, b))));
+		}
+		hypot_scalar(x + i, y + i, out + i, n - i);
+	}
+
+	SI_SIMD_TARGET("avx2") SI_SIMD_NO_CONTRACT inline void hypot_avx2(const float* x, const float* y, float* out, std::size_t n)
+	{
+		std::size_t i = 0;
+		for (; i + 8 <= n; i += 8)
+		{
+			const auto a = _mm256_loadu_ps(x + i);
+			const auto b = _mm256_loadu_ps(y + i);
+			_mm256_storeu_ps(out + i, _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(a, a), _mm256_mul_ps(b, b))));
+		}
+		hypot_scalar(x + i, y + i, out + i, n - i);
+	}
+
+	SI_SIMD_TARGET("avx2") SI_SIMD_NO_CONTRACT inline void hypot_avx2(const double* x, const double* y, double* out, std::size_t n)
+	{
+		std::size_t i = 0;
+		for (; i + 4 <= n; i += 4)
+		{
+			const auto a = _mm256_loadu_pd(x + i);
+			const auto b = _mm256_loadu_pd(y + i);
+			_mm256_storeu_pd(out + i, _mm256_sqrt_pd(_mm256_add_pd(_mm256_mul_pd(a, a), _mm256_mul_pd(b, b))));
+		}
+		hypot_scalar(x + i, y + i, out + i, n - i);
+	}
+
+	SI_SIMD_TARGET("avx512f") SI_SIMD_NO_CONTRACT inline void hypot_avx512(const float* x, const float* y, float* out, std::size_t n)
+	{
+		std::size_t i = 0;
+		for (; i + 16 <= n; i += 16)
+		{
+			const auto a = _mm512_loadu_ps(x + i);
+			const auto b = _mm512_loadu_ps(y + i);
+			_mm512_storeu_ps(out + i, _mm512_sqrt_ps(_mm512_add_ps(_mm512_mul_ps(a, a), _mm512_mul_ps(b, b))));
+		}
+		hypot_scalar(x + i, y + i, out + i, n - i);
+	}
+
+	SI_SIMD_TARGET("avx512f") SI_SIMD_NO_CONTRACT inline void hypot_avx512(const double* x, const double* y, double* out, std::size_t n)
+	{
+		std::size_t i = 0;
+		for (; i + 8 <= n; i += 8)
+		{
+			const auto a = _mm512_loadu_pd(x + i);
+			const auto b = _mm512_loadu_pd(y + i);
+			_mm512_storeu_pd(out + i, _mm512_sqrt_pd(_mm512_add_pd(_mm512_mul_pd(a, a), _mm512_mul_pd(b, b))));
+		}
+		hypot_scalar(x + i, y + i, out + i, n - i);
+	}
+	SI_SIMD_TARGET("avx2,f16c") inline void widen_half_avx2(const std::uint16_t* in, float* out, std::size_t n)
+	{
+		std::size_t i = 0;
+		for (; i + 8 <= n; i += 8)
+			_mm256_storeu_ps(out + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i))));
+		widen_half_scalar(in + i, out + i, n - i);
+	}
+
+	SI_SIMD_TARGET("avx2,f16c") inline void narrow_half_avx2(const float* in, std::uint16_t* out, std::size_t n)
+	{
+		std::size_t i = 0;
+		for (; i + 8 <= n; i += 8)
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT));
+		narrow_half_scalar(in + i, out + i, n - i);
+	}
+
+	SI_SIMD_TARGET("avx512f") inline void widen_half_avx512(const std::uint16_t* in, float* out, std::size_t n)
+	{
+		std::size_t i = 0;
+		for (; i + 16 <= n; i += 16)
+			_mm512_storeu_ps(out + i, _mm512_cvtph_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i))));
+		widen_half_scalar(in + i, out + i, n - i);
+	}
+
+	SI_SIMD_TARGET("avx512f") inline void narrow_half_avx512(const float* in, std::uint16_t* out, std::size_t n)
+	{
+		std::size_t i = 0;
+		for (; i + 16 <= n; i += 16)
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm512_cvtps_ph(_mm512_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT));
+		narrow_half_scalar(in + i, out + i, n - i);
+	}
+
+	SI_SIMD_TARGET("sse2") inline void widen_bfloat16_sse2(const std::uint16_t* in, float* out, std::size_t n)
+	{
+		std::size_t i = 0;
+		const auto zero = _mm_setzero_si128();
+		for (; i + 8 <= n; i += 8)
+		{
+			const auto bits = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+			_mm_storeu_ps(out + i, _mm_castsi128_ps(_mm_unpacklo_epi16(zero, bits)));
+			_mm_storeu_ps(out + i + 4, _mm_castsi128_ps(_mm_unpackhi_epi16(zero, bits)));
+		}
+		widen_bfloat16_scalar(in + i, out + i, n - i);
+	}
+
+	//Rounded upper halves of four floats, sign extended from bit 15 so the signed pack keeps every bit
+	SI_SIMD_TARGET("sse2") inline __m128i bfloat16_round_sse2(__m128 value)
+	{
+		const auto x = _mm_castps_si128(value);
+		const auto nan = _mm_cmpgt_epi32(_mm_and_si128(x, _mm_set1_epi32(0x7FFF'FFFF)), _mm_set1_epi32(0x7F80'0000));
+		const auto odd = _mm_and_si128(_mm_srli_epi32(x, 16), _mm_set1_epi32(1));
+		const auto rounded = _mm_srli_epi32(_mm_add_epi32(x, _mm_add_epi32(odd, _mm_set1_epi32(0x7FFF))), 16);
+		const auto quiet = _mm_or_si128(_mm_srli_epi32(x, 16), _mm_set1_epi32(0x0040));
+		const auto bits = _mm_or_si128(_mm_and_si128(nan, quiet), _mm_andnot_si128(nan, rounded));
+		return _mm_srai_epi32(_mm_slli_epi32(bits, 16), 16);
+	}
+
+	SI_SIMD_TARGET("sse2") inline void narrow_bfloat16_sse2(const float* in, std::uint16_t* out, std::size_t n)
+	{
+		std::size_t i = 0;
+		for (; i + 8 <= n; i += 8)
+		{
+			const auto low = bfloat16_round_sse2(_mm_loadu_ps(in + i));
+			const auto high = bfloat16_round_sse2(_mm_loadu_ps(in + i + 4));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packs_epi32(low, high));
+		}
+		narrow_bfloat16_scalar(in + i, out + i, n - i);
+	}
+
+	SI_SIMD_TARGET("avx2") inline void widen_bfloat16_avx2(const std::uint16_t* in, float* out, std::size_t n)
+	{
+		std::size_t i = 0;
+		for (; i + 8 <= n; i += 8)
+		{
+			const auto bits = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)));
+			_mm256_storeu_ps(out + i, _mm256_castsi256_ps(_mm256_slli_epi32(bits, 16)));
+		}
+		widen_bfloat16_scalar(in + i, out + i, n - i);
+	}
+
+	SI_SIMD_TARGET("avx2") inline void narrow_bfloat16_avx2(const float* in, std::uint16_t* out, std::size_t n)
+	{
+		std::size_t i = 0;
+		for (; i + 8 <= n; i += 8)
+		{
+			const auto x = _mm256_castps_si256(_mm256_loadu_ps(in + i));
+			const auto nan = _mm256_cmpgt_epi32(_mm256_and_si256(x, _mm256_set1_epi32(0x7FFF'FFFF)), _mm256_set1_epi32(0x7F80'0000));
+			const auto odd = _mm256_and_si256(_mm256_srli_epi32(x, 16), _mm256_set1_epi32(1));
+			const auto rounded = _mm256_srli_epi32(_mm256_add_epi32(x, _mm256_add_epi32(odd, _mm256_set1_epi32(0x7FFF))), 16);
+			const auto quiet = _mm256_or_si256(_mm256_srli_epi32(x, 16), _mm256_set1_epi32(0x0040));
+			const auto bits = _mm256_srai_epi32(_mm256_slli_epi32(_mm256_blendv_epi8(rounded, quiet, nan), 16), 16);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packs_epi32(_mm256_castsi256_si128(bits), _mm256_extracti128_si256(bits, 1)));
+		}
+		narrow_bfloat16_scalar(in + i, out + i, n - i);
+	}
+#endif
+
+	//out[i] = in[i] * factor, `in` and `out` may be the same buffer but must not partially overlap
+	template <class T>
+	inline void scale(const T* in, T* out, std::size_t n, T factor, isa target = active_isa())
+	{
+#ifdef SI_SIMD_X86
+		if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>)
+		{
+			switch (target)
+			{
+			case isa::avx512: return scale_avx512(in, out, n, factor);
+			case isa::avx2: return scale_avx2(in, out, n, factor);
+			case isa::sse2: return scale_sse2(in, out, n, factor);
+			case isa::scalar: break;
+			}
+		}
+#endif
+		scale_scalar(in, out, n, factor);
+	}
+
+	//out[i] = sqrt(in[i]), `in` and `out` may be the same buffer
+	template <class T>
+	inline void sqrt(const T* in, T* out, std::size_t n, isa target = active_isa())
+	{
+#ifdef SI_SIMD_X86
+		if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>)
+		{
+			switch (target)
+			{
+			case isa::avx512: return sqrt_avx512(in, out, n);
+			case isa::avx2: return sqrt_avx2(in, out, n);
+			case isa::sse2: return sqrt_sse2(in, out, n);
+			case isa::scalar: break;
+			}
+		}
+#endif
+		sqrt_scalar(in, out, n);
+	}
+
+	//out[i] = sqrt(x[i]^2 + y[i]^2)
+	template <class T>
+	inline void hypot(const T* x, const T* y, T* out, std::size_t n, isa target = active_isa())
+	{
+#ifdef SI_SIMD_X86
+		if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>)
+		{
+			switch (target)
+			{
+			case isa::avx512: return hypot_avx512(x, y, out, n);
+			case isa::avx2: return hypot_avx2(x, y, out, n);
+			case isa::sse2: return hypot_sse2(x, y, out, n);
+			case isa::scalar: break;
+			}
+		}
+#endif
+		hypot_scalar(x, y, out, n);
+	}
+
+	//Half precision bits to float. The vector kernels need F16C next to AVX2 or AVX-512.
+	inline void widen_half(const std::uint16_t* in, float* out, std::size_t n, isa target = active_isa())
+	{
+#ifdef SI_SIMD_X86
+		if (has_f16c())
+		{
+			switch (target)
+			{
+			case isa::avx512: return widen_half_avx512(in, out, n);
+			case isa::avx2: return widen_half_avx2(in, out, n);
+			case isa::sse2: case isa::scalar: break;
+			}
+		}
+#endif
+		widen_half_scalar(in, out, n);
+	}
+
+	inline void narrow_half(const float* in, std::uint16_t* out, std::size_t n, isa target = active_isa())
+	{
+#ifdef SI_SIMD_X86
+		if (has_f16c())
+		{
+			switch (target)
+			{
+			case isa::avx512: return narrow_half_avx512(in, out, n);
+			case isa::avx2: return narrow_half_avx2(in, out, n);
+			case isa::sse2: case isa::scalar: break;
+			}
+		}
+#endif
+		narrow_half_scalar(in, out, n);
+	}
+
+	inline void widen_bfloat16(const std::uint16_t* in, float* out, std::size_t n, isa target = active_isa())
+	{
+#ifdef SI_SIMD_X86
+		switch (target)
+		{
+		case isa::avx512: case isa::avx2: return widen_bfloat16_avx2(in, out, n);
+		case isa::sse2: return widen_bfloat16_sse2(in, out, n);
+		case isa::scalar: break;
+		}
+#endif
+		widen_bfloat16_scalar(in, out, n);
+	}
+
+	inline void narrow_bfloat16(const float* in, std::uint16_t* out, std::size_t n, isa target = active_isa())
+	{
+#ifdef SI_SIMD_X86
+		switch (target)
+		{
+		case isa::avx512: case isa::avx2: return narrow_bfloat16_avx2(in, out, n);
+		case isa::sse2: return narrow_bfloat16_sse2(in, out, n);
+		case isa::scalar: break;
+		}
+#endif
+		narrow_bfloat16_scalar(in, out, n);
+	}
+}
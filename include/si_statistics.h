@@ -0,0 +1,316 @@
+#pragma once
+#include "si.h"
+#include "si_container.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <type_traits>
+#include <vector>
+
+//Online estimators that keep the unit of their input. Every estimator uses memory independent of
+//the number of samples and has a merge() to combine partial results of threads or shards.
+namespace si
+{
+
+	namespace details
+	{
+		template <class Unit, class Other>
+		concept sample_c = unit_c<Other> && std::same_as<typename Other::type, typename Unit::type>
+			&& same_exponent_c<Unit::Descriptor(), Other::Descriptor()>;
+
+		template <class Unit, class Other>
+		constexpr typename Unit::type sample_value(Other other)
+		{
+			return rescale<conversion_factor(Other::Descriptor(), Unit::Descriptor())>(other.value);
+		}
+	}
+
+	//Count, mean, variance (Welford), min and max. The variance has the squared unit, e.g. second^2.
+	template <unit_c Unit>
+	class running_stats
+	{
+	public:
+		using unit_type = Unit;
+		using type = typename Unit::type;
+		static_assert(std::is_floating_point_v<type>, "running_stats needs a floating point value type");
+
+		template <class Other>
+			requires details::sample_c<Unit, Other>
+		void add(Other sample)
+		{
+			const auto x = details::sample_value<Unit>(sample);
+			++count_;
+			const auto delta = x - mean_;
+			mean_ += delta / static_cast<type>(count_);
+			m2_ += delta * (x - mean_);
+			min_ = std::min(min_, x);
+			max_ = std::max(max_, x);
+		}
+
+		//Chan et al. pairwise update, exact for any split of the samples
+		void merge(const running_stats& other)
+		{
+			if (other.count_ == 0)
+				return;
+			if (count_ == 0)
+			{
+				*this = other;
+				return;
+			}
+
+			const auto n = static_cast<type>(count_ + other.count_);
+			const auto delta = other.mean_ - mean_;
+			mean_ += delta * static_cast<type>(other.count_) / n;
+			m2_ += other.m2_ + delta * delta * static_cast<type>(count_) * static_cast<type>(other.count_) / n;
+			count_ += other.count_;
+			min_ = std::min(min_, other.min_);
+			max_ = std::max(max_, other.max_);
+		}
+
+		[[nodiscard]] std::uint64_t count() const { return count_; }
+		[[nodiscard]] Unit mean() const { return Unit{ mean_ }; }
+		[[nodiscard]] Unit min() const { assert(count_ != 0); return Unit{ min_ }; }
+		[[nodiscard]] Unit max() const { assert(count_ != 0); return Unit{ max_ }; }
+
+		//Population variance, divides by n
+		[[nodiscard]] auto variance() const
+		{
+			return details::make_product<Unit, Unit>(count_ == 0 ? type{} : m2_ / static_cast<type>(count_));
+		}
+
+		//Sample variance, divides by n - 1
+		[[nodiscard]] auto sample_variance() const
+		{
+			return details::make_product<Unit, Unit>(count_ < 2 ? type{} : m2_ / static_cast<type>(count_ - 1));
+		}
+
+		[[nodiscard]] Unit stddev() const
+		{
+			return Unit{ count_ == 0 ? type{} : std::sqrt(m2_ / static_cast<type>(count_)) };
+		}
+
+	private:
+		std::uint64_t count_ = 0;
+		type mean_{};
+		type m2_{};
+		type min_ = std::numeric_limits<type>::infinity();
+		type max_ = -std::numeric_limits<type>::infinity();
+	};
+
+	//Fixed width bins between two edges, samples outside go to the underflow and overflow counts, NaN to its own count
+	template <unit_c Unit>
+	class histogram
+	{
+	public:
+		using unit_type = Unit;
+		using type = typename Unit::type;
+
+		histogram(Unit lower, Unit upper, std::size_t bins) :
+			lower_(lower.value), upper_(upper.value), scale_(static_cast<type>(bins) / (upper.value - lower.value)), counts_(bins)
+		{
+			assert(bins != 0 && upper.value > lower.value);
+		}
+
+		template <class Other>
+			requires details::sample_c<Unit, Other>
+		void add(Other sample, std::uint64_t weight = 1)
+		{
+			const auto x = details::sample_value<Unit>(sample);
+			if (x != x)
+				nan_ += weight;
+			else if (x < lower_)
+				underflow_ += weight;
+			else if (x >= upper_)
+				overflow_ += weight;
+			else
+				counts_[std::min(static_cast<std::size_t>((x - lower_) * scale_), counts_.size() - 1)] += weight;
+		}
+
+		//Both histograms need the same edges
+		void merge(const histogram& other)
+		{
+			assert(lower_ == other.lower_ && upper_ == other.upper_ && counts_.size() == other.counts_.size());
+			for (std::size_t i = 0; i < counts_.size(); ++i)
+				counts_[i] += other.counts_[i];
+			underflow_ += other.underflow_;
+			overflow_ += other.overflow_;
+			nan_ += other.nan_;
+		}
+
+		[[nodiscard]] std::size_t bins() const { return counts_.size(); }
+		[[nodiscard]] std::uint64_t count(std::size_t bin) const { return counts_[bin]; }
+		[[nodiscard]] std::uint64_t underflow() const { return underflow_; }
+		[[nodiscard]] std::uint64_t overflow() const { return overflow_; }
+		[[nodiscard]] std::uint64_t nan_count() const { return nan_; }
+
+		//Lower edge of `bin`, edge(bins()) is the upper edge of the last bin
+		[[nodiscard]] Unit edge(std::size_t bin) const
+		{
+			return Unit{ lower_ + (upper_ - lower_) * static_cast<type>(bin) / static_cast<type>(counts_.size()) };
+		}
+
+	private:
+		type lower_;
+		type upper_;
+		type scale_;
+		std::vector<std::uint64_t> counts_;
+		std::uint64_t underflow_ = 0;
+		std::uint64_t overflow_ = 0;
+		std::uint64_t nan_ = 0;
+	};
+
+	//Merging t-digest (Dunning and Ertl) with the arcsine scale function: at most about `compression`
+	//centroids, small ones near the tails, so extreme quantiles like p99.9 stay accurate.
+	template <unit_c Unit>
+	class quantile_sketch
+	{
+	public:
+		using unit_type = Unit;
+		using type = typename Unit::type;
+		static_assert(std::is_floating_point_v<type>, "quantile_sketch needs a floating point value type");
+
+		explicit quantile_sketch(std::size_t compression = 200) : compression_(static_cast<double>(compression))
+		{
+			centroids_.reserve(compression * 2);
+			buffer_.reserve(compression * 5);
+		}
+
+		template <class Other>
+			requires details::sample_c<Unit, Other>
+		void add(Other sample)
+		{
+			const auto x = details::sample_value<Unit>(sample);
+			min_ = std::min(min_, x);
+			max_ = std::max(max_, x);
+			push({ x, 1.0 });
+		}
+
+		void merge(const quantile_sketch& other)
+		{
+			//push grows buffer_ and may compress centroids_, so `other` is copied first in case it is *this
+			auto pending = other.centroids_;
+			pending.insert(pending.end(), other.buffer_.begin(), other.buffer_.end());
+			min_ = std::min(min_, other.min_);
+			max_ = std::max(max_, other.max_);
+			for (const auto& c : pending)
+				push(c);
+		}
+
+		[[nodiscard]] std::uint64_t count() const
+		{
+			return static_cast<std::uint64_t>(total_weight() + 0.5);
+		}
+
+		//q in [0, 1], interpolated between centroid centers and the exact min and max
+		[[nodiscard]] Unit quantile(double q) const
+		{
+			compress();
+			assert(!centroids_.empty());
+			q = std::clamp(q, 0.0, 1.0);
+
+			const auto total = total_weight();
+			const auto target = q * total;
+			if (centroids_.size() == 1)
+				return Unit{ interpolate(min_, max_, q) };
+			if (target <= centroids_.front().weight / 2)
+				return Unit{ interpolate(min_, centroids_.front().mean, target / (centroids_.front().weight / 2)) };
+
+			auto cumulative = centroids_.front().weight / 2;
+			for (std::size_t i = 1; i < centroids_.size(); ++i)
+			{
+				const auto step = (centroids_[i - 1].weight + centroids_[i].weight) / 2;
+				if (target <= cumulative + step)
+					return Unit{ interpolate(centroids_[i - 1].mean, centroids_[i].mean, (target - cumulative) / step) };
+				cumulative += step;
+			}
+			const auto tail = centroids_.back().weight / 2;
+			return Unit{ interpolate(centroids_.back().mean, max_, (target - cumulative) / tail) };
+		}
+
+		[[nodiscard]] std::size_t centroids() const
+		{
+			compress();
+			return centroids_.size();
+		}
+
+	private:
+		struct centroid
+		{
+			type mean;
+			double weight;
+		};
+
+		static type interpolate(type a, type b, double t)
+		{
+			return a + static_cast<type>(std::clamp(t, 0.0, 1.0)) * (b - a);
+		}
+
+		double total_weight() const
+		{
+			auto total = 0.0;
+			for (const auto& c : centroids_)
+				total += c.weight;
+			for (const auto& c : buffer_)
+				total += c.weight;
+			return total;
+		}
+
+		void push(centroid c)
+		{
+			if (buffer_.size() == buffer_.capacity())
+				compress();
+			buffer_.push_back(c);
+		}
+
+		//k(q) = compression / (2 pi) * asin(2q - 1) and its inverse
+		double k_of_q(double q) const { return compression_ / (2 * std::numbers::pi) * std::asin(2 * q - 1); }
+		double q_of_k(double k) const { return (std::sin(std::min(k, compression_ / 4) * 2 * std::numbers::pi / compression_) + 1) / 2; }
+
+		void compress() const
+		{
+			if (buffer_.empty())
+				return;
+
+			buffer_.insert(buffer_.end(), centroids_.begin(), centroids_.end());
+			std::sort(buffer_.begin(), buffer_.end(), [](const centroid& a, const centroid& b) { return a.mean < b.mean; });
+
+			auto total = 0.0;
+			for (const auto& c : buffer_)
+				total += c.weight;
+
+			centroids_.clear();
+			auto current = buffer_.front();
+			auto so_far = 0.0;
+			auto limit = total * q_of_k(k_of_q(0.0) + 1);
+			for (std::size_t i = 1; i < buffer_.size(); ++i)
+			{
+				const auto& next = buffer_[i];
+				if (so_far + current.weight + next.weight <= limit)
+				{
+					current.weight += next.weight;
+					current.mean += static_cast<type>((next.mean - current.mean) * (next.weight / current.weight));
+				}
+				else
+				{
+					so_far += current.weight;
+					centroids_.push_back(current);
+					limit = total * q_of_k(k_of_q(std::min(so_far / total, 1.0)) + 1);
+					current = next;
+				}
+			}
+			centroids_.push_back(current);
+			buffer_.clear();
+		}
+
+		double compression_;
+		type min_ = std::numeric_limits<type>::infinity();
+		type max_ = -std::numeric_limits<type>::infinity();
+		//Compressing is a cache of the merged state, quantile() stays const
+		mutable std::vector<centroid> centroids_;
+		mutable std::vector<centroid> buffer_;
+	};
+}
@@ -0,0 +1,371 @@
+#pragma once
+#include "si.h"
+#include "si_container.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//Interpolation tables of sampled curves, e.g. vapor pressure over temperature. The samples are converted
+//into the table units once on construction, lookups of the same units are a search and a short polynomial.
+//Inputs outside the sampled range are clamped to the first or last sample.
+namespace si
+{
+
+	namespace interpolation
+	{
+		struct linear_t {};
+		//Piecewise cubic Hermite, the slopes are second order differences of the samples
+		struct cubic_t {};
+
+		inline constexpr linear_t linear{};
+		inline constexpr cubic_t cubic{};
+	}
+
+	namespace details
+	{
+		template <class M>
+		concept interpolation_c = std::same_as<M, interpolation::linear_t> || std::same_as<M, interpolation::cubic_t>;
+
+		template <class Unit, class Other>
+		concept table_input_c = unit_c<Other> && std::same_as<typename Other::type, typename Unit::type>
+			&& same_exponent_c<Unit::Descriptor(), Other::Descriptor()>;
+
+		//Range of samples in any scale of Unit
+		template <class R, class Unit>
+		concept table_range_c = quantity_range_c<R> && table_input_c<Unit, range_unit_t<R>>;
+
+		template <class Unit, class Other>
+		constexpr typename Unit::type table_input(Other other)
+		{
+			return rescale<conversion_factor(Other::Descriptor(), Unit::Descriptor())>(other.value);
+		}
+
+		//Values of a range in the scale of Unit
+		template <class Unit, class R>
+		std::vector<typename Unit::type> table_values(const R& range)
+		{
+			constexpr auto factor = conversion_factor(range_unit_t<R>::Descriptor(), Unit::Descriptor());
+			auto in = std::as_const(range).values();
+			auto result = std::vector<typename Unit::type>(in.size());
+			for (std::size_t i = 0; i < in.size(); ++i)
+				result[i] = rescale<factor>(in[i]);
+			return result;
+		}
+
+		//Strictly increasing sample positions of one table dimension
+		template <class T>
+		class table_axis
+		{
+		public:
+			table_axis() = default;
+
+			explicit table_axis(std::vector<T> knots) : knots_(std::move(knots)), inverse_widths_(knots_.size() - 1)
+			{
+				assert(knots_.size() >= 2);
+				const auto step = (knots_.back() - knots_.front()) / static_cast<T>(knots_.size() - 1);
+				uniform_ = true;
+				for (std::size_t i = 1; i < knots_.size(); ++i)
+				{
+					assert(knots_[i - 1] < knots_[i]);
+					const auto width = knots_[i] - knots_[i - 1];
+					inverse_widths_[i - 1] = T{ 1 } / width;
+					if (std::abs(width - step) > step * 64 * std::numeric_limits<T>::epsilon())
+						uniform_ = false;
+				}
+				inverse_step_ = T{ 1 } / step;
+			}
+
+			table_axis(T start, T step, std::size_t size) : knots_(size), inverse_widths_(size - 1, T{ 1 } / step), inverse_step_(T{ 1 } / step), uniform_(true)
+			{
+				assert(size >= 2 && step > T{});
+				for (std::size_t i = 0; i < size; ++i)
+					knots_[i] = start + step * static_cast<T>(i);
+			}
+
+			[[nodiscard]] std::size_t size() const { return knots_.size(); }
+			[[nodiscard]] bool uniform() const { return uniform_; }
+			[[nodiscard]] const T* data() const { return knots_.data(); }
+			[[nodiscard]] T front() const { return knots_.front(); }
+			[[nodiscard]] T back() const { return knots_.back(); }
+			[[nodiscard]] T operator[](std::size_t i) const { return knots_[i]; }
+			[[nodiscard]] T inverse_width(std::size_t i) const { return inverse_widths_[i]; }
+			[[nodiscard]] T inverse_step() const { return inverse_step_; }
+
+			[[nodiscard]] T clamp(T x) const
+			{
+				return std::min(std::max(x, knots_.front()), knots_.back());
+			}
+
+			//Interval [knots[i], knots[i + 1]] of a clamped x
+			[[nodiscard]] std::size_t interval(T x) const
+			{
+				return uniform_ ? uniform_interval(x) : search_interval(x);
+			}
+
+			[[nodiscard]] std::size_t uniform_interval(T x) const
+			{
+				return std::min(static_cast<std::size_t>((x - knots_.front()) * inverse_step_), knots_.size() - 2);
+			}
+
+			//Binary search with conditional moves, the number of steps only depends on the size
+			[[nodiscard]] std::size_t search_interval(T x) const
+			{
+				const T* base = knots_.data();
+				std::size_t length = knots_.size() - 1;
+				while (length > 1)
+				{
+					const auto half = length / 2;
+					base = base[half] <= x ? base + half : base;
+					length -= half;
+				}
+				return static_cast<std::size_t>(base - knots_.data());
+			}
+
+		private:
+			std::vector<T> knots_;
+			std::vector<T> inverse_widths_;
+			T inverse_step_{};
+			bool uniform_ = false;
+		};
+
+		//Uniform grid lookups, c2 and c3 are only read for cubic polynomials. The restrict parameters
+		//and 32 bit indices let the compiler use gather instructions.
+		template <std::size_t terms, class T>
+		void uniform_lookup(const T* __restrict in, T* __restrict out, std::size_t n, const table_axis<T>& axis,
+			const T* __restrict c0, const T* __restrict c1, const T* __restrict c2, const T* __restrict c3)
+		{
+			const auto front = axis.front();
+			const auto back = axis.back();
+			const auto inverse = axis.inverse_step();
+			const auto last = static_cast<std::int32_t>(axis.size() - 2);
+			const auto* __restrict knots = axis.data();
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				const auto v = std::min(std::max(in[i], front), back);
+				const auto j = std::min(static_cast<std::int32_t>((v - front) * inverse), last);
+				const auto t = v - knots[j];
+				if constexpr (terms == 2)
+					out[i] = c0[j] + c1[j] * t;
+				else
+					out[i] = c0[j] + t * (c1[j] + t * (c2[j] + t * c3[j]));
+			}
+		}
+
+		//Slope at sample i, exact for quadratics, one sided at the ends
+		template <class T>
+		T sample_slope(const table_axis<T>& x, const std::vector<T>& y, std::size_t i)
+		{
+			const auto n = x.size();
+			if (n == 2)
+				return (y[1] - y[0]) / (x[1] - x[0]);
+
+			const auto at = std::clamp<std::size_t>(i, 1, n - 2);
+			const auto h0 = x[at] - x[at - 1];
+			const auto h1 = x[at + 1] - x[at];
+			const auto d0 = (y[at] - y[at - 1]) / h0;
+			const auto d1 = (y[at + 1] - y[at]) / h1;
+			if (i == 0)
+				return ((2 * h0 + h1) * d0 - h0 * d1) / (h0 + h1);
+			if (i == n - 1)
+				return ((2 * h1 + h0) * d1 - h1 * d0) / (h0 + h1);
+			return (h1 * d0 + h0 * d1) / (h0 + h1);
+		}
+	}
+
+	//Curve Y(X) through samples. The polynomial of every interval is computed on construction,
+	//a lookup is a clamp, an interval search (a multiply on uniform grids) and Horner's rule in x - x[i].
+	template <unit_c X, unit_c Y, details::interpolation_c Method = interpolation::linear_t>
+	class lookup_table
+	{
+	public:
+		using input_unit = X;
+		using result_unit = Y;
+		using type = typename Y::type;
+		static_assert(std::same_as<type, typename X::type>, "Inputs and results need the same value type");
+		static_assert(std::is_floating_point_v<type>, "lookup_table needs a floating point value type");
+
+		lookup_table() = default;
+
+		//Samples at increasing positions `x`, both ranges may use any scale of X and Y
+		template <details::table_range_c<X> RX, details::table_range_c<Y> RY>
+		lookup_table(const RX& x, const RY& y, Method = {}) :
+			lookup_table(details::table_axis<type>(details::table_values<X>(x)), details::table_values<Y>(y))
+		{
+		}
+
+		//Samples y[i] at start + i * step
+		template <class Start, class Step, details::table_range_c<Y> RY>
+			requires details::table_input_c<X, Start> && details::table_input_c<X, Step>
+		lookup_table(Start start, Step step, const RY& y, Method = {}) :
+			lookup_table(details::table_axis<type>(details::table_input<X>(start), details::table_input<X>(step), y.size()), details::table_values<Y>(y))
+		{
+		}
+
+		[[nodiscard]] std::size_t size() const { return x_.size(); }
+		[[nodiscard]] bool uniform() const { return x_.uniform(); }
+		[[nodiscard]] X front() const { return X{ x_.front() }; }
+		[[nodiscard]] X back() const { return X{ x_.back() }; }
+
+		template <class Other>
+			requires details::table_input_c<X, Other>
+		[[nodiscard]] Y operator()(Other x) const
+		{
+			const auto v = x_.clamp(details::table_input<X>(x));
+			return Y{ evaluate(x_.interval(v), v) };
+		}
+
+		//`in` and `out` need the same size. On a uniform grid the loop has no branch and vectorizes,
+		//32 bit indices and one array per coefficient let it use gather instructions.
+		void operator()(quantity_span<const X> in, quantity_span<Y> out) const
+		{
+			assert(in.size() == out.size());
+			const auto* a = in.data();
+			auto* o = out.data();
+			if (!x_.uniform())
+			{
+				for (std::size_t i = 0; i < in.size(); ++i)
+				{
+					const auto v = x_.clamp(a[i]);
+					o[i] = evaluate(x_.search_interval(v), v);
+				}
+				return;
+			}
+
+			assert(x_.size() <= static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max()));
+			details::uniform_lookup<terms>(a, o, in.size(), x_, coefficients_[0].data(), coefficients_[1].data(),
+				terms == 4 ? coefficients_[terms - 2].data() : nullptr, terms == 4 ? coefficients_[terms - 1].data() : nullptr);
+		}
+
+		template <details::quantity_range_c R>
+			requires std::same_as<details::range_unit_t<R>, X>
+		[[nodiscard]] quantity_vector<Y> operator()(const R& in) const
+		{
+			auto result = quantity_vector<Y>(in.size());
+			(*this)(quantity_span<const X>(std::as_const(in).values()), result.span());
+			return result;
+		}
+
+	private:
+		static constexpr std::size_t terms = std::same_as<Method, interpolation::cubic_t> ? 4 : 2;
+
+		lookup_table(details::table_axis<type> x, std::vector<type> y) : x_(std::move(x))
+		{
+			assert(y.size() == x_.size() && x_.size() <= static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max()));
+			for (auto& c : coefficients_)
+				c.resize(x_.size() - 1);
+			for (std::size_t i = 0; i + 1 < x_.size(); ++i)
+			{
+				const auto h = x_[i + 1] - x_[i];
+				const auto delta = (y[i + 1] - y[i]) / h;
+				coefficients_[0][i] = y[i];
+				if constexpr (terms == 2)
+					coefficients_[1][i] = delta;
+				else
+				{
+					const auto m0 = details::sample_slope(x_, y, i);
+					const auto m1 = details::sample_slope(x_, y, i + 1);
+					coefficients_[1][i] = m0;
+					coefficients_[2][i] = (3 * delta - 2 * m0 - m1) / h;
+					coefficients_[3][i] = (m0 + m1 - 2 * delta) / (h * h);
+				}
+			}
+		}
+
+		type evaluate(std::size_t i, type x) const
+		{
+			const auto t = x - x_[i];
+			if constexpr (terms == 2)
+				return coefficients_[0][i] + coefficients_[1][i] * t;
+			else
+				return coefficients_[0][i] + t * (coefficients_[1][i] + t * (coefficients_[2][i] + t * coefficients_[3][i]));
+		}
+
+		details::table_axis<type> x_;
+		//Polynomial of interval i in x - x[i], one array per power
+		std::array<std::vector<type>, terms> coefficients_;
+	};
+
+	//Surface Y(X1, X2) on a rectangular grid, bilinear between the four surrounding samples
+	template <unit_c X1, unit_c X2, unit_c Y>
+	class lookup_table_2d
+	{
+	public:
+		using result_unit = Y;
+		using type = typename Y::type;
+		static_assert(std::same_as<type, typename X1::type> && std::same_as<type, typename X2::type>, "Inputs and results need the same value type");
+		static_assert(std::is_floating_point_v<type>, "lookup_table_2d needs a floating point value type");
+
+		lookup_table_2d() = default;
+
+		//values[i * x2.size() + j] is the sample at (x1[i], x2[j])
+		template <details::table_range_c<X1> R1, details::table_range_c<X2> R2, details::table_range_c<Y> RY>
+		lookup_table_2d(const R1& x1, const R2& x2, const RY& values) :
+			x1_(details::table_values<X1>(x1)), x2_(details::table_values<X2>(x2)), values_(details::table_values<Y>(values))
+		{
+			assert(values_.size() == x1_.size() * x2_.size());
+		}
+
+		[[nodiscard]] std::size_t rows() const { return x1_.size(); }
+		[[nodiscard]] std::size_t columns() const { return x2_.size(); }
+
+		template <class A, class B>
+			requires details::table_input_c<X1, A> && details::table_input_c<X2, B>
+		[[nodiscard]] Y operator()(A a, B b) const
+		{
+			const auto u = x1_.clamp(details::table_input<X1>(a));
+			const auto v = x2_.clamp(details::table_input<X2>(b));
+			return Y{ evaluate(x1_.interval(u), u, x2_.interval(v), v) };
+		}
+
+		//All three spans need the same size
+		void operator()(quantity_span<const X1> a, quantity_span<const X2> b, quantity_span<Y> out) const
+		{
+			assert(a.size() == b.size() && a.size() == out.size());
+			const auto* __restrict pa = a.data();
+			const auto* __restrict pb = b.data();
+			auto* __restrict o = out.data();
+			if (x1_.uniform() && x2_.uniform())
+			{
+				for (std::size_t i = 0; i < a.size(); ++i)
+				{
+					const auto u = x1_.clamp(pa[i]);
+					const auto v = x2_.clamp(pb[i]);
+					o[i] = evaluate(x1_.uniform_interval(u), u, x2_.uniform_interval(v), v);
+				}
+			}
+			else
+			{
+				for (std::size_t i = 0; i < a.size(); ++i)
+				{
+					const auto u = x1_.clamp(pa[i]);
+					const auto v = x2_.clamp(pb[i]);
+					o[i] = evaluate(x1_.interval(u), u, x2_.interval(v), v);
+				}
+			}
+		}
+
+	private:
+		type evaluate(std::size_t i, type u, std::size_t j, type v) const
+		{
+			const auto tu = (u - x1_[i]) * x1_.inverse_width(i);
+			const auto tv = (v - x2_[j]) * x2_.inverse_width(j);
+			const auto* row = values_.data() + i * x2_.size() + j;
+			const auto* next = row + x2_.size();
+			const auto low = row[0] + tv * (row[1] - row[0]);
+			const auto high = next[0] + tv * (next[1] - next[0]);
+			return low + tu * (high - low);
+		}
+
+		details::table_axis<type> x1_;
+		details::table_axis<type> x2_;
+		std::vector<type> values_;
+	};
+}
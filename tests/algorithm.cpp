@@ -0,0 +1,90 @@
+#include "si_algorithm.h"
+#include "si_literals.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <cmath>
+#include <vector>
+
+TEST_CASE("Sum and mean keep the unit", "[Algorithm]") {
+    auto lengths = si::quantity_vector<si::kilo_meter<float>>{ si::kilo_meter{ 1.0f }, si::kilo_meter{ 2.0f }, si::kilo_meter{ 3.0f } };
+
+    auto total = si::sum(lengths);
+    static_assert(std::same_as<decltype(total), si::kilo_meter<float>>);
+    REQUIRE(total.value == 6.0f);
+
+    auto average = si::mean(lengths.span());
+    static_assert(std::same_as<decltype(average), si::kilo_meter<float>>);
+    REQUIRE(average.value == 2.0f);
+
+    auto plain = std::vector<si::second<double>>{ si::second{ 1.5 }, si::second{ 2.5 } };
+    REQUIRE(si::sum(plain).value == 4.0);
+}
+
+
+TEST_CASE("Compensated summation of many small values", "[Algorithm]") {
+    //1 + 10^7 * 10^-8 in float, the naive sum never moves away from 1
+    auto values = si::quantity_vector<si::meter<float>>(10'000'001, si::meter{ 1e-8f });
+    values[0] = si::meter{ 1.0f };
+
+    REQUIRE(si::sum(values, si::summation::naive).value == 1.0f);
+    REQUIRE(si::sum(values, si::summation::kahan).value == Catch::Approx(1.1f).epsilon(1e-6f));
+    REQUIRE(si::sum(values, si::summation::pairwise).value == Catch::Approx(1.1f).epsilon(1e-5f));
+
+    //Accumulated in double and rounded to float once
+    const auto exact = static_cast<float>(1.0 + 1e7 * static_cast<double>(1e-8f));
+    auto wide = si::sum(si::execution::par, values, si::summation::wide);
+    static_assert(std::same_as<decltype(wide), si::meter<float>>);
+    REQUIRE(wide.value == exact);
+    REQUIRE(si::mean(values, si::summation::wide).value == Catch::Approx(exact / 10'000'001.0f));
+}
+
+
+TEST_CASE("Wide dot product of float values", "[Algorithm]") {
+    //Products of 2^12 + 1 need 25 bits, float keeps 24
+    auto force = si::quantity_vector<si::newton<float>>(1000, si::newton{ 4097.0f });
+    auto distance = si::quantity_vector<si::meter<float>>(1000, si::meter{ 4097.0f });
+
+    auto work = si::dot(force, distance, si::summation::wide);
+    static_assert(std::same_as<decltype(work), si::joule<float>>);
+    REQUIRE(work.value == static_cast<float>(1000.0 * 4097.0 * 4097.0));
+    REQUIRE(si::norm(distance, si::summation::wide).value == Catch::Approx(std::sqrt(1000.0 * 4097.0 * 4097.0)));
+}
+
+
+TEST_CASE("Parallel backends agree with the sequential result", "[Algorithm]") {
+    auto values = si::quantity_vector<si::meter<double>>(1 << 20);
+    for (std::size_t i = 0; i < values.size(); ++i)
+        values[i] = si::meter{ static_cast<double>(i % 1000) * 0.001 };
+
+    auto pool = si::execution::thread_pool(4);
+    REQUIRE(pool.size() == 4);
+
+    const auto expected = si::sum(si::execution::seq, values, si::summation::kahan).value;
+    REQUIRE(si::sum(si::execution::par, values, si::summation::kahan).value == Catch::Approx(expected).epsilon(1e-12));
+    REQUIRE(si::sum(si::execution::on(pool), values, si::summation::kahan).value == Catch::Approx(expected).epsilon(1e-12));
+
+    //The chunking is fixed, so the same policy gives the same bits every time
+    REQUIRE(si::sum(si::execution::on(pool), values).value == si::sum(si::execution::on(pool), values).value);
+
+    REQUIRE(si::min(si::execution::on(pool), values).value == 0.0);
+    REQUIRE(si::max(si::execution::par, values).value == 0.999);
+}
+
+
+TEST_CASE("Dot product and norm", "[Algorithm]") {
+    auto force = si::quantity_vector<si::newton<float>>{ si::newton{ 1.0f }, si::newton{ 2.0f }, si::newton{ 2.0f } };
+    auto distance = si::quantity_vector<si::meter<float>>{ si::meter{ 3.0f }, si::meter{ 1.0f }, si::meter{ 0.5f } };
+
+    auto work = si::dot(force, distance);
+    static_assert(std::same_as<decltype(work), si::joule<float>>);
+    REQUIRE(work.value == 6.0f);
+
+    auto length = si::norm(force);
+    static_assert(std::same_as<decltype(length), si::newton<float>>);
+    REQUIRE(length.value == 3.0f);
+
+    REQUIRE(si::min(distance).value == 0.5f);
+    REQUIRE(si::max(distance).value == 3.0f);
+}
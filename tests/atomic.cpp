@@ -0,0 +1,66 @@
+#include "si_atomic.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <thread>
+#include <vector>
+
+namespace
+{
+    template <class Atomic, class Quantity>
+    concept can_fetch_add = requires(Atomic& a, Quantity q) { a.fetch_add(q); };
+}
+
+TEST_CASE("Atomic quantity", "[Atomic]") {
+    auto energy = si::atomic<si::joule<double>>{ si::joule{ 1.0 } };
+    static_assert(si::atomic<si::joule<double>>::is_always_lock_free);
+
+    auto before = energy.fetch_add(si::joule{ 2.0 });
+    REQUIRE(before.value == 1.0);
+    REQUIRE(energy.load().value == 3.0);
+
+    energy.store(si::kilo_meter{ 1.0 } * si::newton{ 1.0 });
+    REQUIRE(energy.load().value == 1000.0);
+
+    auto expected = si::joule{ 1000.0 };
+    REQUIRE(energy.compare_exchange_strong(expected, si::joule{ 5.0 }));
+    REQUIRE_FALSE(energy.compare_exchange_strong(expected, si::joule{ 6.0 }));
+    REQUIRE(expected.value == 5.0);
+
+    energy -= si::joule{ 1.0 };
+    REQUIRE(static_cast<si::joule<double>>(energy).value == 4.0);
+
+    //Only quantities `joule + Other` accepts can be added
+    static_assert(can_fetch_add<si::atomic<si::joule<double>>, si::joule<double>>);
+    static_assert(!can_fetch_add<si::atomic<si::joule<double>>, si::meter<double>>);
+    static_assert(!can_fetch_add<si::atomic<si::joule<double>>, si::joule<float>>);
+}
+
+
+TEST_CASE("Atomic integer quantity converts before the add", "[Atomic]") {
+    auto bytes = si::atomic<si::gram<long long>>{};
+    bytes += si::kilo_gram<long long>{ 3 };
+    bytes += si::gram<long long>{ 5 };
+    REQUIRE(bytes.load().value == 3005);
+}
+
+
+TEST_CASE("Sharded counter from many threads", "[Atomic]") {
+    auto energy = si::sharded_counter<si::joule<double>>(6);
+    REQUIRE(energy.shards() == 8);
+
+    constexpr int threads = 12;
+    constexpr int adds = 20000;
+    {
+        auto workers = std::vector<std::jthread>{};
+        for (int t = 0; t < threads; ++t)
+            workers.emplace_back([&] {
+                for (int i = 0; i < adds; ++i)
+                    energy += si::kilo_meter{ 0.001 } * si::newton{ 1.0 };
+            });
+    }
+
+    REQUIRE(energy.load().value == threads * adds);
+    REQUIRE(energy.reset().value == threads * adds);
+    REQUIRE(energy.load().value == 0.0);
+}
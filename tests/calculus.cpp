@@ -0,0 +1,153 @@
+#include "si_calculus.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+TEST_CASE("Integral units come from the scalar operators", "[Calculus]") {
+    auto power = si::quantity_vector<si::watt<double>>(5, si::watt{ 2.0 });
+
+    auto energy = si::integrate(power, si::second{ 0.5 });
+    static_assert(std::same_as<decltype(energy), si::joule<double>>);
+    REQUIRE(energy.value == Catch::Approx(4.0));
+
+    auto position = si::quantity_vector<si::meter<double>>(4);
+    for (std::size_t i = 0; i < position.size(); ++i)
+        position[i] = si::meter{ 3.0 * static_cast<double>(i) };
+    auto velocity = si::differentiate(position, si::second{ 1.0 });
+    static_assert(std::same_as<decltype(velocity), si::quantity_vector<si::meters_per_second<double>>>);
+    for (std::size_t i = 0; i < velocity.size(); ++i)
+        REQUIRE(velocity.values()[i] == Catch::Approx(3.0));
+}
+
+
+TEST_CASE("Trapezoid and Simpson on uniform samples", "[Calculus]") {
+    //sin over [0, pi] integrates to 2
+    for (std::size_t n : { 101u, 100u, 3u, 4u })
+    {
+        const auto h = std::numbers::pi / static_cast<double>(n - 1);
+        auto y = si::quantity_vector<si::meter<double>>(n);
+        for (std::size_t i = 0; i < n; ++i)
+            y[i] = si::meter{ std::sin(h * static_cast<double>(i)) };
+
+        const auto trapezoid = si::integrate(y, si::second{ h }, si::integration::trapezoid).value;
+        const auto simpson = si::integrate(y, si::second{ h }, si::integration::simpson).value;
+        if (n > 50)
+        {
+            REQUIRE(std::abs(trapezoid - 2.0) < 2e-4);
+            REQUIRE(std::abs(simpson - 2.0) < 1e-7);
+        }
+        REQUIRE(std::abs(simpson - 2.0) <= std::abs(trapezoid - 2.0));
+    }
+
+    //Simpson is exact for cubics, the last interval of an odd count for quadratics
+    auto cubic = si::quantity_vector<si::meter<double>>(7);
+    auto quadratic = si::quantity_vector<si::meter<double>>(8);
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+        const auto x = 0.5 * static_cast<double>(i);
+        if (i < 7)
+            cubic[i] = si::meter{ x * x * x - 2 * x + 1 };
+        quadratic[i] = si::meter{ 3 * x * x - x };
+    }
+    REQUIRE(si::integrate(cubic, si::second{ 0.5 }, si::integration::simpson).value == Catch::Approx(81.0 / 4.0 - 9.0 + 3.0));
+    REQUIRE(si::integrate(quadratic, si::second{ 0.5 }, si::integration::simpson).value == Catch::Approx(3.5 * 3.5 * 3.5 - 3.5 * 3.5 / 2));
+}
+
+
+TEST_CASE("Non uniform sampling", "[Calculus]") {
+    const auto times = std::vector<double>{ 0.0, 0.1, 0.35, 0.4, 0.9, 1.3, 1.35, 2.0 };
+    auto t = si::quantity_vector<si::second<double>>(times.size());
+    auto y = si::quantity_vector<si::meter<double>>(times.size());
+    for (std::size_t i = 0; i < times.size(); ++i)
+    {
+        t[i] = si::second{ times[i] };
+        y[i] = si::meter{ times[i] * times[i] };
+    }
+
+    //x^2 over [0, 2] is 8 / 3, Simpson is exact for quadratics on any spacing
+    REQUIRE(si::integrate(y, t, si::integration::simpson).value == Catch::Approx(8.0 / 3.0));
+    REQUIRE(si::integrate(y, t).value == Catch::Approx(8.0 / 3.0).epsilon(0.05));
+
+    //The central difference is exact for quadratics, the ends are one sided
+    auto slope = si::differentiate(y, t);
+    for (std::size_t i = 1; i + 1 < times.size(); ++i)
+        REQUIRE(slope.values()[i] == Catch::Approx(2 * times[i]));
+    REQUIRE(slope.values()[0] == Catch::Approx(times[1]));
+    REQUIRE(slope.values()[times.size() - 1] == Catch::Approx(times[times.size() - 1] + times[times.size() - 2]));
+}
+
+
+TEST_CASE("Chunked integration matches one batch", "[Calculus]") {
+    constexpr std::size_t n = 10007;
+    auto y = si::quantity_vector<si::watt<double>>(n);
+    auto t = si::quantity_vector<si::second<double>>(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const auto x = 0.001 * static_cast<double>(i) + 0.0002 * static_cast<double>(i % 3);
+        t[i] = si::second{ x };
+        y[i] = si::watt{ std::cos(x) };
+    }
+
+    const auto uniform_trapezoid = si::integrate(y, si::second{ 0.001 });
+    const auto uniform_simpson = si::integrate(y, si::second{ 0.001 }, si::integration::simpson);
+    const auto timed_trapezoid = si::integrate(y, t);
+    const auto timed_simpson = si::integrate(y, t, si::integration::simpson);
+
+    auto a = si::integrator<si::watt<double>, si::second<double>>(si::second{ 0.001 });
+    auto b = si::integrator<si::watt<double>, si::second<double>, si::integration::simpson_t>(si::second{ 0.001 });
+    auto c = si::integrator<si::watt<double>, si::second<double>>{};
+    auto d = si::integrator<si::watt<double>, si::second<double>, si::integration::simpson_t>{};
+
+    //Uneven chunks including empty ones and single samples
+    std::size_t offset = 0;
+    for (std::size_t chunk = 0; offset < n; chunk = (chunk * 7 + 3) % 97)
+    {
+        const auto size = std::min(chunk, n - offset);
+        a.push(y.span().subspan(offset, size));
+        b.push(y.span().subspan(offset, size));
+        c.push(y.span().subspan(offset, size), t.span().subspan(offset, size));
+        d.push(y.span().subspan(offset, size), t.span().subspan(offset, size));
+        offset += size;
+    }
+    static_assert(std::same_as<decltype(a.value()), si::joule<double>>);
+    REQUIRE(a.count() == n);
+    REQUIRE(a.value().value == Catch::Approx(uniform_trapezoid.value).epsilon(1e-12));
+    REQUIRE(b.value().value == Catch::Approx(uniform_simpson.value).epsilon(1e-12));
+    REQUIRE(c.value().value == Catch::Approx(timed_trapezoid.value).epsilon(1e-12));
+    REQUIRE(d.value().value == Catch::Approx(timed_simpson.value).epsilon(1e-12));
+    REQUIRE(d.value().value == Catch::Approx(std::sin(t.values()[n - 1])).epsilon(1e-9));
+
+    //Single samples
+    auto e = si::integrator<si::watt<double>, si::second<double>, si::integration::simpson_t>(si::second{ 0.001 });
+    for (std::size_t i = 0; i < n; ++i)
+        e.push(y[i]);
+    REQUIRE(e.value().value == Catch::Approx(uniform_simpson.value).epsilon(1e-12));
+}
+
+
+TEST_CASE("Chunked differentiation lags by one sample", "[Calculus]") {
+    constexpr std::size_t n = 50;
+    auto y = si::quantity_vector<si::meter<double>>(n);
+    for (std::size_t i = 0; i < n; ++i)
+        y[i] = si::meter{ std::exp(0.1 * static_cast<double>(i)) };
+    const auto batch = si::differentiate(y, si::second{ 0.1 });
+
+    auto derivative = si::differentiator<si::meter<double>, si::second<double>>(si::second{ 0.1 });
+    auto out = si::quantity_vector<si::meters_per_second<double>>(n);
+    std::size_t written = 0;
+    written += derivative.push(y.span().subspan(0, 1), out.span().subspan(written));
+    REQUIRE(written == 0);
+    written += derivative.push(y.span().subspan(1, 20), out.span().subspan(written));
+    REQUIRE(written == 20);
+    written += derivative.push(y.span().subspan(21), out.span().subspan(written));
+    REQUIRE(written == n - 1);
+    out[n - 1] = derivative.finish();
+
+    for (std::size_t i = 0; i < n; ++i)
+        REQUIRE(out.values()[i] == batch.values()[i]);
+    REQUIRE(batch.values()[25] == Catch::Approx(std::exp(2.5)).epsilon(2e-3));
+}
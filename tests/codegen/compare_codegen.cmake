@@ -0,0 +1,63 @@
+# Compares the instructions of every unit_<name> function in ASSEMBLY with raw_<name>.
+# Instructions are compared as a sorted list, so scheduling differences pass but any extra,
+# missing or different instruction (a leftover multiply, a loop that is no longer vectorized) fails.
+# Usage: cmake -DASSEMBLY=<file.s> -P compare_codegen.cmake
+
+if(NOT EXISTS "${ASSEMBLY}")
+	message(FATAL_ERROR "Assembly file '${ASSEMBLY}' does not exist")
+endif()
+
+file(STRINGS "${ASSEMBLY}" lines)
+
+set(current "")
+set(functions "")
+foreach(line IN LISTS lines)
+	if(line MATCHES "^((raw|unit)_[A-Za-z0-9_]+):")
+		set(current ${CMAKE_MATCH_1})
+		set(body_${current} "")
+		list(APPEND functions ${current})
+	elseif(line MATCHES "^[A-Za-z_][A-Za-z0-9_]*:" OR line MATCHES "^[ \t]*\\.size" OR line MATCHES "^\\.Lfunc_end")
+		set(current "")
+	elseif(current)
+		# Local labels and constant pool entries only differ in their numbering, registers in their allocation
+		string(REGEX REPLACE "[ \t]*#.*$" "" line "${line}")
+		string(REGEX REPLACE "\\.L[A-Za-z]*[0-9_]+" ".L" line "${line}")
+		string(REGEX REPLACE "%[a-z][a-z0-9]*" "%reg" line "${line}")
+		string(REGEX REPLACE "[ \t]+" " " line "${line}")
+		string(STRIP "${line}" line)
+		if(line MATCHES "^\\.L:$" OR (line MATCHES "^[a-z]" AND NOT line MATCHES "^\\."))
+			list(APPEND body_${current} "${line}")
+		endif()
+	endif()
+endforeach()
+
+set(failures 0)
+set(compared 0)
+foreach(function IN LISTS functions)
+	if(NOT function MATCHES "^raw_(.+)$")
+		continue()
+	endif()
+	set(name ${CMAKE_MATCH_1})
+	if(NOT DEFINED body_unit_${name})
+		message(SEND_ERROR "raw_${name} has no unit_${name} counterpart")
+		math(EXPR failures "${failures} + 1")
+		continue()
+	endif()
+
+	math(EXPR compared "${compared} + 1")
+	set(raw ${body_raw_${name}})
+	set(unit ${body_unit_${name}})
+	list(SORT raw)
+	list(SORT unit)
+	if(NOT raw STREQUAL unit)
+		list(JOIN body_raw_${name} "\n" raw_text)
+		list(JOIN body_unit_${name} "\n" unit_text)
+		message(SEND_ERROR "unit_${name} does not compile to the same instructions as raw_${name}\n--- raw_${name}\n${raw_text}\n--- unit_${name}\n${unit_text}")
+		math(EXPR failures "${failures} + 1")
+	endif()
+endforeach()
+
+if(compared EQUAL 0)
+	message(FATAL_ERROR "No raw_/unit_ function pairs found in ${ASSEMBLY}")
+endif()
+message(STATUS "${compared} kernels compared, ${failures} differ")
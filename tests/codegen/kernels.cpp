@@ -0,0 +1,123 @@
+#include "si.h"
+#include "si_expression.h"
+
+// Every unit_<name> function has to compile to the same instructions as raw_<name>,
+// compare_codegen.cmake checks that on the generated assembly.
+
+extern "C" {
+
+	void raw_add(const float* a, const float* b, float* out, int n)
+	{
+		for (int i = 0; i < n; ++i)
+			out[i] = a[i] + b[i];
+	}
+
+	void unit_add(const si::meter<float>* a, const si::meter<float>* b, si::meter<float>* out, int n)
+	{
+		for (int i = 0; i < n; ++i)
+			out[i] = a[i] + b[i];
+	}
+
+	void raw_force(const float* mass, const float* acceleration, float* out, int n)
+	{
+		for (int i = 0; i < n; ++i)
+			out[i] = mass[i] * acceleration[i];
+	}
+
+	void unit_force(const si::kilo_gram<float>* mass, const si::meters_per_second_squared<float>* acceleration, si::newton<float>* out, int n)
+	{
+		for (int i = 0; i < n; ++i)
+			out[i] = mass[i] * acceleration[i];
+	}
+
+	void raw_convert(const float* in, float* out, int n)
+	{
+		for (int i = 0; i < n; ++i)
+			out[i] = in[i] * 1000.0f;
+	}
+
+	void unit_convert(const si::kilo_meter<float>* in, si::meter<float>* out, int n)
+	{
+		auto meters = si::quantity_span<si::meter<float>>(&out->value, n);
+		for (int i = 0; i < n; ++i)
+			meters[i] = in[i];
+	}
+
+	void raw_convert_int(const int* in, int* out, int n)
+	{
+		for (int i = 0; i < n; ++i)
+			out[i] = in[i] * 1000;
+	}
+
+	void unit_convert_int(const si::kilo_meter<int>* in, si::meter<int>* out, int n)
+	{
+		auto meters = si::quantity_span<si::meter<int>>(&out->value, n);
+		for (int i = 0; i < n; ++i)
+			meters[i] = in[i];
+	}
+
+	void raw_kilo_int(const int* in, int* out, int n)
+	{
+		for (int i = 0; i < n; ++i)
+			out[i] = in[i] / 1000;
+	}
+
+	void unit_kilo_int(const si::meter<int>* in, si::kilo_meter<int>* out, int n)
+	{
+		auto kilo_meters = si::quantity_span<si::kilo_meter<int>>(&out->value, n);
+		for (int i = 0; i < n; ++i)
+			kilo_meters[i] = in[i];
+	}
+
+	void raw_kilo(const float* in, float* out, int n)
+	{
+		for (int i = 0; i < n; ++i)
+			out[i] = in[i] * 0.001f;
+	}
+
+	void unit_kilo(const si::meter<float>* in, si::kilo_meter<float>* out, int n)
+	{
+		for (int i = 0; i < n; ++i)
+			out[i] = si::kilo(in[i]);
+	}
+
+	float raw_infer(float a, float b)
+	{
+		return a / b / b;
+	}
+
+	si::meters_per_second_squared<float> unit_infer(si::meter<float> a, si::second<float> b)
+	{
+		return si::infer_cast(a / b / b);
+	}
+
+	float raw_sum(const float* in, int n)
+	{
+		float sum = 0;
+		for (int i = 0; i < n; ++i)
+			sum = sum + in[i];
+		return sum;
+	}
+
+	si::joule<float> unit_sum(const si::joule<float>* in, int n)
+	{
+		auto sum = si::joule<float>{ 0 };
+		for (int i = 0; i < n; ++i)
+			sum = sum + in[i];
+		return sum;
+	}
+
+	void raw_energy(const float* m, const float* v, const float* h, float* out, std::size_t n)
+	{
+		for (std::size_t i = 0; i < n; ++i)
+			out[i] = 0.5f * m[i] * v[i] * v[i] + m[i] * 9.81f * h[i];
+	}
+
+	void unit_energy(const si::kilo_gram<float>* m, const si::meters_per_second<float>* v, const si::meter<float>* h, si::joule<float>* out, std::size_t n)
+	{
+		auto mass = si::lazy(si::quantity_span<const si::kilo_gram<float>>(&m->value, n));
+		auto velocity = si::lazy(si::quantity_span<const si::meters_per_second<float>>(&v->value, n));
+		auto height = si::lazy(si::quantity_span<const si::meter<float>>(&h->value, n));
+		si::assign(si::quantity_span<si::joule<float>>(&out->value, n), 0.5f * mass * velocity * velocity + mass * si::meters_per_second_squared{ 9.81f } * height);
+	}
+}
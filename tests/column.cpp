@@ -0,0 +1,111 @@
+#include "si_column.h"
+#include "si_literals.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+
+namespace
+{
+    std::filesystem::path column_path(const char* name)
+    {
+        return std::filesystem::temp_directory_path() / name;
+    }
+
+    template <class T>
+    void patch_header(const std::filesystem::path& path, std::size_t offset, T value)
+    {
+        auto* file = std::fopen(path.string().c_str(), "r+b");
+        REQUIRE(file);
+        std::fseek(file, static_cast<long>(offset), SEEK_SET);
+        std::fwrite(&value, sizeof(value), 1, file);
+        std::fclose(file);
+    }
+}
+
+TEST_CASE("Column round trip without conversion", "[Column]") {
+    const auto path = column_path("si_column_meters.bin");
+    auto lengths = si::quantity_vector<si::meter<float>>{ si::meter{ 1.0f }, si::meter{ 2.5f }, si::meter{ -3.0f } };
+    REQUIRE(si::write_column(path, lengths) == std::errc{});
+    REQUIRE(std::filesystem::file_size(path) == 64 + 3 * sizeof(float));
+
+    auto column = si::open_column<si::meter<float>>(path);
+    REQUIRE(column.has_value());
+    REQUIRE_FALSE(column->converted());
+    REQUIRE(column->size() == 3);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(column->data()) % si::details::simd_alignment == 0);
+
+    si::meter<float> second = column->span()[1];
+    REQUIRE(second.value == 2.5f);
+    REQUIRE(column->values()[2] == -3.0f);
+
+    std::filesystem::remove(path);
+}
+
+
+TEST_CASE("Column in another scale is converted on open", "[Column]") {
+    const auto path = column_path("si_column_kilometers.bin");
+    auto distances = si::quantity_vector<si::kilo_meter<double>>(1000, si::kilo_meter{ 1.5 });
+    REQUIRE(si::write_column(path, distances.span()) == std::errc{});
+
+    auto column = si::open_column<si::meter<double>>(path);
+    REQUIRE(column.has_value());
+    REQUIRE(column->converted());
+    REQUIRE(column->size() == 1000);
+    REQUIRE(column->values()[999] == 1500.0);
+
+    //The file itself keeps its scale
+    auto original = si::open_column<si::kilo_meter<double>>(path);
+    REQUIRE(original.has_value());
+    REQUIRE(original->values()[0] == 1.5);
+
+    std::filesystem::remove(path);
+}
+
+
+TEST_CASE("Column header mismatches", "[Column]") {
+    const auto path = column_path("si_column_seconds.bin");
+    auto times = si::quantity_vector<si::second<float>>(16, si::second{ 1.0f });
+    REQUIRE(si::write_column(path, times) == std::errc{});
+
+    REQUIRE(si::open_column<si::meter<float>>(path).error() == std::errc::argument_out_of_domain);
+    REQUIRE(si::open_column<si::second<double>>(path).error() == std::errc::not_supported);
+
+    //Scales no unit has, which would overflow or take forever to apply
+    using header = si::details::column_header;
+    patch_header(path, offsetof(header, exp10), std::int32_t{ 2'000'000'000 });
+    REQUIRE(si::open_column<si::second<float>>(path).error() == std::errc::invalid_argument);
+    patch_header(path, offsetof(header, exp10), std::int32_t{ 0 });
+    patch_header(path, offsetof(header, pi), std::int32_t{ -1'000'000 });
+    REQUIRE(si::open_column<si::second<float>>(path).error() == std::errc::invalid_argument);
+    patch_header(path, offsetof(header, pi), std::int32_t{ 0 });
+    patch_header(path, offsetof(header, den), std::int64_t{ 1 } << 40);
+    REQUIRE(si::open_column<si::second<float>>(path).error() == std::errc::invalid_argument);
+    patch_header(path, offsetof(header, den), std::int64_t{ 1 });
+    REQUIRE(si::open_column<si::second<float>>(path).has_value());
+
+    const auto counts_path = column_path("si_column_counts.bin");
+    REQUIRE(si::write_column(counts_path, si::quantity_vector<si::second<std::int64_t>>(4, si::second<std::int64_t>{ 1 })) == std::errc{});
+    patch_header(counts_path, offsetof(header, num), std::int64_t{ 1'000'000'000'000'001 });
+    patch_header(counts_path, offsetof(header, exp10), std::int32_t{ 5 });
+    REQUIRE(si::open_column<si::second<std::int64_t>>(counts_path).error() == std::errc::invalid_argument);
+    patch_header(counts_path, offsetof(header, num), std::int64_t{ 1 });
+    patch_header(counts_path, offsetof(header, exp10), std::int32_t{ 20 });
+    REQUIRE(si::open_column<si::second<std::int64_t>>(counts_path).error() == std::errc::invalid_argument);
+    std::filesystem::remove(counts_path);
+
+    std::filesystem::resize_file(path, 64 + 8 * sizeof(float));
+    REQUIRE(si::open_column<si::second<float>>(path).error() == std::errc::invalid_argument);
+
+    std::filesystem::resize_file(path, 10);
+    REQUIRE(si::open_column<si::second<float>>(path).error() == std::errc::invalid_argument);
+
+    std::filesystem::remove(path);
+    REQUIRE_FALSE(si::open_column<si::second<float>>(path).has_value());
+
+    const auto missing_directory = column_path("si_column_missing") / "seconds.bin";
+    REQUIRE(si::write_column(missing_directory, times) == std::errc::no_such_file_or_directory);
+}
@@ -0,0 +1,148 @@
+#include "si_compact.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+TEST_CASE("Mixed value types promote like the built in types", "[Compact]") {
+    auto sum = si::meter{ 1.5f } + si::kilo_meter{ 0.002 };
+    static_assert(std::same_as<decltype(sum)::type, double>);
+    static_assert(decltype(sum)::Descriptor().factor == si::details::ratio{});
+    REQUIRE(sum.value == Catch::Approx(3.5));
+
+    auto difference = si::kilo_meter{ 0.002 } - si::meter{ 1.5f };
+    static_assert(std::same_as<decltype(difference)::type, double>);
+    static_assert(decltype(difference)::Descriptor().factor == si::details::ratio{ 1, 1, 3 });
+    REQUIRE(difference.value == Catch::Approx(0.0005));
+
+    auto area = si::meter{ 3 } * si::meter{ 0.5f };
+    static_assert(std::same_as<decltype(area), si::SquareMeters<float>>);
+    REQUIRE(area.value == 1.5f);
+
+    auto speed = si::meter{ 10.0 } / si::second{ 4 };
+    static_assert(std::same_as<decltype(speed), si::meters_per_second<double>>);
+    REQUIRE(speed.value == 2.5);
+
+    //Same type operations and scalar factors are unchanged
+    static_assert(std::same_as<decltype(si::meter{ 1.0f } + si::meter{ 2.0f })::type, float>);
+    static_assert(std::same_as<decltype(si::meter{ 1.0f } * 2.0f)::type, float>);
+    constexpr auto promoted = si::second{ 2 } + si::second{ 0.25 };
+    static_assert(promoted.value == 2.25);
+}
+
+
+TEST_CASE("Half and bfloat16 round to nearest even", "[Compact]") {
+    using namespace si::details::simd;
+
+    //Exactly representable values round trip
+    for (float value : { 0.0f, -0.0f, 1.0f, -2.5f, 65504.0f, 0x1p-14f, 0x1p-24f, 1000.5f })
+        REQUIRE(std::bit_cast<std::uint32_t>(half_to_float(half_from_float(value))) == std::bit_cast<std::uint32_t>(value));
+    for (float value : { 0.0f, -3.0f, 1.5f, 0x1p100f, -0x1p-120f })
+        REQUIRE(bfloat16_to_float(bfloat16_from_float(value)) == value);
+
+    //Ties go to the even significand
+    REQUIRE(half_to_float(half_from_float(1.0f + 0x1p-11f)) == 1.0f);
+    REQUIRE(half_to_float(half_from_float(1.0f + 3 * 0x1p-11f)) == 1.0f + 0x1p-9f);
+    REQUIRE(half_to_float(half_from_float(0x1p-25f)) == 0.0f);
+    REQUIRE(half_to_float(half_from_float(3 * 0x1p-25f)) == 0x1p-23f);
+    REQUIRE(bfloat16_to_float(bfloat16_from_float(1.0f + 0x1p-8f)) == 1.0f);
+    REQUIRE(bfloat16_to_float(bfloat16_from_float(1.0f + 3 * 0x1p-8f)) == 1.0f + 0x1p-6f);
+
+    //Overflow, infinity and NaN
+    constexpr auto infinity = std::numeric_limits<float>::infinity();
+    REQUIRE(half_from_float(65520.0f) == 0x7C00);
+    REQUIRE(half_from_float(65519.0f) == 0x7BFF);
+    REQUIRE(half_from_float(-infinity) == 0xFC00);
+    REQUIRE(std::isnan(half_to_float(half_from_float(std::numeric_limits<float>::quiet_NaN()))));
+    REQUIRE(bfloat16_from_float(infinity) == 0x7F80);
+    REQUIRE(bfloat16_from_float(std::numeric_limits<float>::max()) == 0x7F80);
+    REQUIRE(std::isnan(bfloat16_to_float(bfloat16_from_float(std::bit_cast<float>(0x7F80'0001u)))));
+}
+
+
+TEST_CASE("SIMD widening and narrowing agree on every instruction set", "[Compact]") {
+    using si::details::simd::isa;
+
+    //Every 16 bit pattern, and floats around the rounding boundaries of both formats
+    constexpr std::size_t n = 65536 + 37;
+    auto bits = std::vector<std::uint16_t>(n);
+    auto values = std::vector<float>(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        bits[i] = static_cast<std::uint16_t>(i);
+        values[i] = std::bit_cast<float>(static_cast<std::uint32_t>(i * 0x0001'0FFFu + (i & 1) * 0x0000'8000u));
+    }
+
+    auto expected_half = std::vector<std::uint16_t>(n);
+    auto expected_bfloat16 = std::vector<std::uint16_t>(n);
+    auto expected_widened_half = std::vector<float>(n);
+    auto expected_widened_bfloat16 = std::vector<float>(n);
+    si::details::simd::narrow_half(values.data(), expected_half.data(), n, isa::scalar);
+    si::details::simd::narrow_bfloat16(values.data(), expected_bfloat16.data(), n, isa::scalar);
+    si::details::simd::widen_half(bits.data(), expected_widened_half.data(), n, isa::scalar);
+    si::details::simd::widen_bfloat16(bits.data(), expected_widened_bfloat16.data(), n, isa::scalar);
+
+    const auto same_bits = [](const std::vector<float>& a, const std::vector<float>& b) {
+        for (std::size_t i = 0; i < a.size(); ++i)
+            if (std::bit_cast<std::uint32_t>(a[i]) != std::bit_cast<std::uint32_t>(b[i]))
+                return false;
+        return true;
+    };
+
+    for (auto target : { isa::sse2, isa::avx2, isa::avx512 })
+    {
+        if (target > si::details::simd::active_isa())
+            continue;
+        auto narrowed = std::vector<std::uint16_t>(n);
+        auto widened = std::vector<float>(n);
+        si::details::simd::narrow_half(values.data(), narrowed.data(), n, target);
+        REQUIRE(narrowed == expected_half);
+        si::details::simd::narrow_bfloat16(values.data(), narrowed.data(), n, target);
+        REQUIRE(narrowed == expected_bfloat16);
+        si::details::simd::widen_half(bits.data(), widened.data(), n, target);
+        REQUIRE(same_bits(widened, expected_widened_half));
+        si::details::simd::widen_bfloat16(bits.data(), widened.data(), n, target);
+        REQUIRE(same_bits(widened, expected_widened_bfloat16));
+    }
+}
+
+
+TEST_CASE("compact_vector loads and stores batches", "[Compact]") {
+    constexpr std::size_t n = 41;
+    auto lengths = si::quantity_vector<si::meter<float>>(n);
+    for (std::size_t i = 0; i < n; ++i)
+        lengths[i] = si::meter{ 0.25f * static_cast<float>(i) - 3.0f };
+
+    auto half = si::compact_vector<si::meter<float>, si::storage::half>(lengths.span());
+    auto bfloat = si::compact_vector<si::meter<float>, si::storage::bfloat16>(lengths.span());
+    REQUIRE(half.size() == n);
+
+    //Quarter steps are exact in both formats
+    auto widened = half.widened();
+    static_assert(std::same_as<decltype(widened), si::quantity_vector<si::meter<float>>>);
+    REQUIRE(std::vector<float>(widened.values().begin(), widened.values().end()) == std::vector<float>(lengths.values().begin(), lengths.values().end()));
+    for (std::size_t i = 0; i < n; ++i)
+        REQUIRE(bfloat.load(i).value == lengths.values()[i]);
+
+    //Partial batch
+    auto window = si::quantity_vector<si::meter<float>>(10);
+    half.load(5, window.span());
+    for (auto& v : window.values())
+        v *= 2.0f;
+    half.store(5, window.span());
+    REQUIRE(half.load(5).value == 2 * lengths.values()[5]);
+    REQUIRE(half.load(15).value == lengths.values()[15]);
+    REQUIRE(half.load(4).value == lengths.values()[4]);
+
+    //Single values are rescaled into the stored unit
+    half.store(0, si::kilo_meter{ 0.001f });
+    REQUIRE(half.load(0).value == 1.0f);
+    bfloat.push_back(si::meter{ 1.0f / 3.0f });
+    REQUIRE(bfloat.size() == n + 1);
+    REQUIRE(bfloat.load(n).value == Catch::Approx(1.0f / 3.0f).epsilon(1.0 / 256));
+}
@@ -0,0 +1,55 @@
+#include "si_container.h"
+#include "si_literals.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+
+TEST_CASE("Quantity vector storage", "[Container]") {
+    auto lengths = si::quantity_vector<si::meter<float>>(100);
+
+    REQUIRE(lengths.size() == 100);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(lengths.data()) % si::details::simd_alignment == 0);
+
+    lengths[3] = si::meter{ 2.0f };
+    lengths[4] = si::kilo_meter{ 1.0f };
+
+    REQUIRE(lengths.values()[3] == 2.0f);
+    REQUIRE(lengths.values()[4] == 1000.0f);
+
+    si::meter<float> third = lengths[3];
+    REQUIRE(third.value == 2.0f);
+}
+
+
+TEST_CASE("Element wise addition", "[Container]") {
+    auto a = si::quantity_vector<si::meter<float>>{ si::meter{ 1.0f }, si::meter{ 2.0f } };
+    auto b = si::quantity_vector<si::kilo_meter<float>>{ si::kilo_meter{ 1.0f }, si::kilo_meter{ 2.0f } };
+
+    auto sum = a + b;
+
+    static_assert(std::same_as<decltype(sum), si::quantity_vector<si::meter<float>>>);
+    REQUIRE(sum.values()[0] == 1001.0f);
+    REQUIRE(sum.values()[1] == 2002.0f);
+
+    auto difference = b.span() - a.span();
+    static_assert(std::same_as<decltype(difference), si::quantity_vector<si::kilo_meter<float>>>);
+    REQUIRE(difference.values()[0] == 0.999f);
+}
+
+
+TEST_CASE("Element wise generating newtons", "[Container]") {
+    auto acceleration = si::quantity_vector<si::meters_per_second_squared<float>>{ si::meters_per_second_squared{ 2.0f }, si::meters_per_second_squared{ 3.0f } };
+    auto mass = si::quantity_vector<si::kilo_gram<float>>(2, si::kilo_gram{ 10.0f });
+
+    auto force = acceleration * mass;
+    static_assert(std::same_as<decltype(force), si::quantity_vector<si::newton<float>>>);
+    REQUIRE(force.values()[1] == 30.0f);
+
+    auto back = force / mass;
+    static_assert(std::same_as<decltype(back), si::quantity_vector<si::meters_per_second_squared<float>>>);
+    REQUIRE(back.values()[0] == 2.0f);
+
+    auto doubled = 2.0f * acceleration;
+    REQUIRE(doubled.values()[1] == 6.0f);
+}
@@ -1,5 +1,6 @@
 #include "si.h"
 #include "si_literals.h"
+#include "si_convert.h"
 
 #include <catch2/catch_test_macros.hpp>
 
@@ -39,4 +40,78 @@ TEST_CASE("Generating newtons", "[Conversions]") {
     static_assert(check, "Generated type is not equal to newton");
 
     REQUIRE(check);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Bulk kilometer to meter", "[Conversions]") {
+    auto kilo_meters = std::vector<si::kilo_meter<float>>(1027);
+    for (std::size_t i = 0; i < kilo_meters.size(); ++i)
+        kilo_meters[i].value = static_cast<float>(i);
+
+    auto meters = std::vector<si::meter<float>>(kilo_meters.size());
+
+    si::convert<si::meter<float>>(std::span<const si::kilo_meter<float>>(kilo_meters), std::span(meters));
+
+    for (std::size_t i = 0; i < meters.size(); ++i)
+        REQUIRE(meters[i].value == (si::meter{ 0.0f } + kilo_meters[i]).value);
+}
+
+
+TEST_CASE("Bulk conversion on every instruction set", "[Conversions]") {
+    using si::details::simd::isa;
+
+    auto input = std::vector<double>(515);
+    for (std::size_t i = 0; i < input.size(); ++i)
+        input[i] = static_cast<double>(i) * 0.5;
+
+    for (auto target : { isa::scalar, isa::sse2, isa::avx2, isa::avx512 }) {
+        if (target > si::details::simd::active_isa())
+            continue;
+
+        //Odd offsets to exercise the unaligned head and tail of every kernel
+        for (std::size_t offset = 0; offset < 3; ++offset) {
+            auto output = std::vector<double>(input.size());
+            const auto n = input.size() - offset;
+            si::details::simd::scale(input.data() + offset, output.data() + offset, n, 3600.0, target);
+
+            for (std::size_t i = offset; i < input.size(); ++i)
+                REQUIRE(output[i] == input[i] * 3600.0);
+        }
+    }
+}
+
+
+TEST_CASE("In place hours to seconds", "[Conversions]") {
+    auto hours = si::quantity_vector<si::hour<float>>(9, si::hour{ 2.0f });
+
+    auto seconds = si::convert_in_place<si::second<float>>(hours.span());
+
+    static_assert(std::same_as<decltype(seconds), si::quantity_span<si::second<float>>>);
+    REQUIRE(seconds.size() == 9);
+    REQUIRE(seconds.values()[8] == 7200.0f);
+}
+
+
+TEST_CASE("Dimensionless results keep the value type", "[Conversions]") {
+    constexpr auto ratio = si::kilo_meter{ 3.0 } / si::kilo_meter{ 2.0 };
+
+    static_assert(std::same_as<std::remove_cv_t<decltype(ratio)>, double>);
+    REQUIRE(ratio == 1.5);
+}
+
+
+TEST_CASE("Exact scale factors", "[Conversions]") {
+    using si::details::ratio;
+
+    static_assert(ratio{ 1000 } == ratio{ 1, 1, 3 });
+    static_assert(ratio{ 1, 2 } == ratio{ 5, 1, -1 });
+    static_assert(ratio{ 60 } * ratio{ 60 } / ratio{ 3600 } == ratio{});
+    static_assert(si::kilo_gram<float>::Descriptor().factor == ratio{});
+    static_assert(si::details::conversion_factor(si::day<float>::Descriptor(), si::minute<float>::Descriptor()) == ratio{ 1440 });
+
+    constexpr auto minutes = si::minute{ 0.0 } + si::day{ 1.0 };
+    static_assert(minutes.value == 1440.0);
+
+    constexpr auto frequency = 2.0 / si::kilo_second{ 1.0 };
+    static_assert(frequency.Descriptor().factor == ratio{ 1, 1000 });
+    REQUIRE(frequency.value == 2.0);
+}
@@ -0,0 +1,105 @@
+#include "si_dynamic.h"
+#include "si_literals.h"
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+TEST_CASE("Packed descriptor round trip", "[Dynamic]") {
+    constexpr auto packed = si::packed_descriptor::of<si::newton<float>::Descriptor()>();
+    static_assert(sizeof(packed) == 8);
+    static_assert(packed.exponent() == si::newton<float>::Descriptor().exponent);
+    static_assert(packed.scale() == 1.0f);
+
+    constexpr auto per_ampere = si::packed_descriptor::of<si::siemens<float>::Descriptor()>();
+    static_assert(per_ampere.exponent() == si::siemens<float>::Descriptor().exponent);
+
+    constexpr auto kilo = si::packed_descriptor::of<si::kilo_meter<float>::Descriptor()>();
+    static_assert(kilo.scale() == 1000.0f);
+    static_assert(kilo.same_exponent(si::packed_descriptor::of<si::meter<float>::Descriptor()>()));
+    static_assert(kilo != si::packed_descriptor::of<si::meter<float>::Descriptor()>());
+
+    REQUIRE(si::packed_descriptor::make({ 8, 0, 0, 0, 0, 0, 0 }, 1.0f).error() == std::errc::result_out_of_range);
+
+    auto seen = std::unordered_set<si::packed_descriptor>{ packed, kilo, packed };
+    REQUIRE(seen.size() == 2);
+}
+
+
+TEST_CASE("Dynamic quantity conversion", "[Dynamic]") {
+    auto distance = si::dynamic_quantity<float>{ si::kilo_meter{ 2.0f } };
+
+    auto meters = distance.as<si::meter<float>>();
+    REQUIRE(meters.has_value());
+    REQUIRE(meters->value == 2000.0f);
+
+    REQUIRE(distance.as<si::kilo_meter<float>>()->value == 2.0f);
+    REQUIRE(distance.as<si::second<float>>().error() == std::errc::argument_out_of_domain);
+}
+
+
+TEST_CASE("Dynamic quantity from text", "[Dynamic]") {
+    constexpr auto text = std::string_view{ "7.5 m s^-2 kg" };
+    auto force = si::dynamic_quantity<float>{};
+    auto [ptr, ec] = si::from_chars(text.data(), text.data() + text.size(), force);
+
+    REQUIRE(ec == std::errc{});
+    REQUIRE(ptr == text.data() + text.size());
+    REQUIRE(force.as<si::newton<float>>()->value == 7.5f);
+
+    constexpr auto unknown = std::string_view{ "1 parsec" };
+    REQUIRE(si::from_chars(unknown.data(), unknown.data() + unknown.size(), force).ec == std::errc::invalid_argument);
+
+    //The bare gram carries its scale like the prefixed one
+    constexpr auto grams = std::string_view{ "2 g" };
+    constexpr auto milligrams = std::string_view{ "2000 mg" };
+    auto mass = si::dynamic_quantity<float>{};
+    auto same_mass = si::dynamic_quantity<float>{};
+    REQUIRE(si::from_chars(grams.data(), grams.data() + grams.size(), mass).ec == std::errc{});
+    REQUIRE(si::from_chars(milligrams.data(), milligrams.data() + milligrams.size(), same_mass).ec == std::errc{});
+    REQUIRE(mass.as<si::kilo_gram<float>>()->value == Catch::Approx(0.002f));
+    REQUIRE(same_mass.as<si::kilo_gram<float>>()->value == Catch::Approx(0.002f));
+}
+
+
+TEST_CASE("Batch conversion checks once", "[Dynamic]") {
+    auto batch = std::vector<si::dynamic_quantity<float>>(100, si::kilo_meter{ 1.5f });
+    auto out = si::quantity_vector<si::meter<float>>(batch.size());
+
+    REQUIRE(si::convert(std::span<const si::dynamic_quantity<float>>(batch), out.span()) == std::errc{});
+    REQUIRE(out.values()[99] == 1500.0f);
+
+    batch[10] = si::meter{ 3.0f };
+    REQUIRE(si::convert(std::span<const si::dynamic_quantity<float>>(batch), out.span()) == std::errc{});
+    REQUIRE(out.values()[10] == 3.0f);
+    REQUIRE(out.values()[11] == 1500.0f);
+
+    batch[20] = si::second{ 1.0f };
+    out.values()[0] = 0.0f;
+    REQUIRE(si::convert(std::span<const si::dynamic_quantity<float>>(batch), out.span()) == std::errc::argument_out_of_domain);
+    REQUIRE(out.values()[0] == 0.0f);
+}
+
+
+TEST_CASE("Dispatch to typed kernels", "[Dynamic]") {
+    auto batch = std::vector<si::dynamic_quantity<float>>(8, si::kilo_gram{ 2.0f });
+
+    auto kilograms = 0.0f;
+    auto typed = false;
+    auto ec = si::dispatch<si::meter<float>, si::kilo_gram<float>>(std::span<const si::dynamic_quantity<float>>(batch), [&](auto values) {
+        typed = std::same_as<decltype(values), si::quantity_vector<si::kilo_gram<float>>>;
+        for (auto v : values.values())
+            kilograms += v;
+    });
+    REQUIRE(ec == std::errc{});
+    REQUIRE(typed);
+    REQUIRE(kilograms == 16.0f);
+
+    auto called = false;
+    ec = si::dispatch<si::meter<float>>(std::span<const si::dynamic_quantity<float>>(batch), [&](auto) { called = true; });
+    REQUIRE(ec == std::errc::argument_out_of_domain);
+    REQUIRE_FALSE(called);
+}
@@ -0,0 +1,57 @@
+#include "si_expression.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("Fused mechanical energy", "[Expression]") {
+    constexpr std::size_t n = 37;
+    auto mass = si::quantity_vector<si::kilo_gram<float>>(n, si::kilo_gram{ 2.0f });
+    auto velocity = si::quantity_vector<si::meters_per_second<float>>(n, si::meters_per_second{ 3.0f });
+    auto height = si::quantity_vector<si::meter<float>>(n, si::meter{ 10.0f });
+    auto g = si::meters_per_second_squared{ 9.81f };
+
+    auto m = si::lazy(mass);
+    auto v = si::lazy(velocity);
+    auto energy = 0.5f * m * v * v + m * g * height;
+
+    static_assert(std::same_as<decltype(energy)::unit_type, si::joule<float>>);
+
+    auto result = si::evaluate(energy);
+    static_assert(std::same_as<decltype(result), si::quantity_vector<si::joule<float>>>);
+    REQUIRE(result.size() == n);
+    REQUIRE(result.values()[n - 1] == 0.5f * 2.0f * 3.0f * 3.0f + 2.0f * 9.81f * 10.0f);
+}
+
+
+TEST_CASE("Lazy scale conversions", "[Expression]") {
+    auto meters = si::quantity_vector<si::meter<double>>(4, si::meter{ 500.0 });
+    auto kilo_meters = si::quantity_vector<si::kilo_meter<double>>(4, si::kilo_meter{ 1.0 });
+
+    auto sum = si::evaluate(si::lazy(meters) + kilo_meters);
+    static_assert(std::same_as<decltype(sum), si::quantity_vector<si::meter<double>>>);
+    REQUIRE(sum.values()[0] == 1500.0);
+
+    auto out = si::quantity_vector<si::kilo_meter<double>>(4);
+    si::assign(out.span(), si::lazy(kilo_meters) - meters);
+    REQUIRE(out.values()[3] == 0.5);
+
+    //In place, the output is also a range of the expression
+    si::assign(meters.span(), si::lazy(meters) * 2.0 + kilo_meters);
+    REQUIRE(meters.values()[0] == 2000.0);
+}
+
+
+TEST_CASE("Lazy ratios", "[Expression]") {
+    auto distance = si::quantity_vector<si::meter<float>>(3, si::meter{ 6.0f });
+    auto time = si::quantity_vector<si::second<float>>(3, si::second{ 2.0f });
+
+    auto speed = si::evaluate(si::lazy(distance) / time);
+    static_assert(std::same_as<decltype(speed), si::quantity_vector<si::meters_per_second<float>>>);
+    REQUIRE(speed.values()[2] == 3.0f);
+
+    auto ratio = si::evaluate(si::lazy(distance) / distance);
+    REQUIRE(ratio.values()[0] == 1.0f);
+
+    auto frequency = si::evaluate(1.0f / si::lazy(time));
+    static_assert(std::same_as<decltype(frequency), si::quantity_vector<si::hertz<float>>>);
+    REQUIRE(frequency.values()[1] == 0.5f);
+}
@@ -47,4 +47,52 @@ TEST_CASE("Base format test", "[Format]") {
     auto x = std::format("{:.2f}", length);
 
     REQUIRE(x == "7.14m A^-1");
-}
\ No newline at end of file
+}
+
+TEST_CASE("Unit suffix is built at compile time", "[Format]") {
+    static_assert(si::details::unit_suffix<si::newton<float>::Descriptor()>.view() == " m s^-2 kg");
+    static_assert(si::details::unit_suffix<si::details::unit_descriptor{ .exponent = {}, .factor = 1 }>.view().empty());
+    static_assert(si::details::unit_suffix<si::details::unit_descriptor{ .exponent = { 1, { -1, 2 }, 0, 0, 0, 0, 0 }, .factor = 1 }>.view() == " m s^-1/2");
+
+    REQUIRE(std::format("{}", si::hertz{ 50 }) == "50 s^-1");
+}
+
+
+TEST_CASE("to_chars", "[Format]") {
+    auto buffer = std::array<char, 32>{};
+    auto velocity = si::meter{ 25.0 } / si::second{ 2.0 };
+
+    auto [end, ec] = si::to_chars(buffer.data(), buffer.data() + buffer.size(), velocity, std::chars_format::fixed, 2);
+
+    REQUIRE(ec == std::errc{});
+    REQUIRE(std::string_view(buffer.data(), end) == "12.50 m s^-1");
+
+    auto too_small = si::to_chars(buffer.data(), buffer.data() + 7, velocity);
+    REQUIRE(too_small.ec == std::errc::value_too_large);
+}
+
+
+TEST_CASE("format_to_n truncates", "[Format]") {
+    auto buffer = std::array<char, 4>{};
+
+    auto [out, size] = si::format_to_n(buffer.data(), buffer.size(), si::kelvin{ 273.5f });
+
+    REQUIRE(size == 7);
+    REQUIRE(out == buffer.data() + buffer.size());
+    REQUIRE(std::string_view(buffer.data(), buffer.size()) == "273.");
+}
+
+
+TEST_CASE("Prefixed units print their symbol", "[Format]") {
+    REQUIRE(std::format("{}", si::kilo_meter{ 1.5 }) == "1.5 km");
+    REQUIRE(std::format("{}", si::prefixed<si::prefix::nano, si::second<double>>{ 250.0 }) == "250 ns");
+    REQUIRE(std::format("{:.1f}", si::giga(si::watt{ 1.2e9 })) == "1.2 GW");
+}
+
+
+TEST_CASE("Wide formatting decodes the UTF-8 symbols", "[Format]") {
+    REQUIRE(std::format(L"{}", si::kilo_meter{ 1.5 }) == L"1.5 km");
+    REQUIRE(std::format(L"{}", si::prefixed<si::prefix::micro, si::second<double>>{ 2.5 }) == L"2.5 µs");
+    REQUIRE(std::format(L"{}", si::prefixed<si::prefix::milli, si::ohm<double>>{ 4.0 }) == L"4 mΩ");
+    REQUIRE(std::format(L"{}", si::newton{ 7.5 }) == L"7.5 m s^-2 kg");
+}
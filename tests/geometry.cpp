@@ -0,0 +1,104 @@
+#include "si_geometry.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("Vector arithmetic keeps units", "[Geometry]") {
+    constexpr auto a = si::vec3{ si::meter{ 1.0f }, si::meter{ 2.0f }, si::meter{ 3.0f } };
+    constexpr auto b = si::vec3{ si::kilo_meter{ 0.001f }, si::kilo_meter{ 0.0f }, si::kilo_meter{ 0.002f } };
+
+    constexpr auto sum = a + b;
+    static_assert(std::same_as<std::remove_cvref_t<decltype(sum)>, si::vec3<si::meter<float>>>);
+    REQUIRE(sum.x.value == 2.0f);
+    REQUIRE(sum.z.value == 5.0f);
+
+    constexpr auto velocity = a / si::second{ 2.0f };
+    static_assert(std::same_as<std::remove_cvref_t<decltype(velocity)>, si::vec3<si::meters_per_second<float>>>);
+    REQUIRE(velocity.y.value == 1.0f);
+
+    constexpr auto scaled = 2.0f * a;
+    REQUIRE(scaled.z.value == 6.0f);
+}
+
+
+TEST_CASE("Dot and cross products", "[Geometry]") {
+    constexpr auto force = si::vec3{ si::newton{ 0.0f }, si::newton{ 0.0f }, si::newton{ 2.0f } };
+    constexpr auto arm = si::vec3{ si::meter{ 3.0f }, si::meter{ 0.0f }, si::meter{ 0.0f } };
+    constexpr auto displacement = si::vec3{ si::meter{ 1.0f }, si::meter{ 1.0f }, si::meter{ 4.0f } };
+
+    constexpr auto work = si::dot(force, displacement);
+    static_assert(std::same_as<std::remove_cvref_t<decltype(work)>, si::joule<float>>);
+    REQUIRE(work.value == 8.0f);
+
+    //Torque has the exponents of a joule
+    constexpr auto torque = si::cross(arm, force);
+    static_assert(std::same_as<std::remove_cvref_t<decltype(torque)>, si::vec3<si::joule<float>>>);
+    REQUIRE(torque.x.value == 0.0f);
+    REQUIRE(torque.y.value == -6.0f);
+    REQUIRE(torque.z.value == 0.0f);
+
+    //Dimensionless products are plain values, like the scalar operators
+    constexpr auto cosine = si::dot(arm, arm) / si::SquareMeters{ 9.0f };
+    REQUIRE(cosine == 1.0f);
+
+    REQUIRE(si::norm(si::vec3{ si::meter{ 3.0f }, si::meter{ 4.0f }, si::meter{ 0.0f } }).value == 5.0f);
+}
+
+
+TEST_CASE("Matrix products", "[Geometry]") {
+    using moment_of_inertia = decltype(si::kilo_gram{ 1.0f } * si::SquareMeters{ 1.0f });
+    auto inertia = si::mat3<moment_of_inertia>::identity();
+    inertia(2, 2).value = 4.0f;
+
+    constexpr auto omega = si::vec3{ si::hertz{ 1.0f }, si::hertz{ 2.0f }, si::hertz{ 3.0f } };
+    auto momentum = inertia * omega;
+    REQUIRE(momentum.x.value == 1.0f);
+    REQUIRE(momentum.z.value == 12.0f);
+
+    auto rotation = si::mat3<si::dimensionless<float>>{};
+    rotation(0, 1).value = -1.0f;
+    rotation(1, 0).value = 1.0f;
+    rotation(2, 2).value = 1.0f;
+
+    constexpr auto p = si::vec3{ si::meter{ 1.0f }, si::meter{ 0.0f }, si::meter{ 5.0f } };
+    auto turned = rotation * p;
+    static_assert(std::same_as<decltype(turned), si::vec3<si::meter<float>>>);
+    REQUIRE(turned.x.value == 0.0f);
+    REQUIRE(turned.y.value == 1.0f);
+    REQUIRE(turned.z.value == 5.0f);
+
+    auto back = si::transpose(rotation) * rotation;
+    REQUIRE(back(0, 0).value == 1.0f);
+    REQUIRE(back(0, 1).value == 0.0f);
+}
+
+
+TEST_CASE("Structure of arrays batches", "[Geometry]") {
+    auto forces = si::vec3_soa<si::newton<float>>(37);
+    auto arms = si::vec3_soa<si::meter<float>>(37);
+    for (std::size_t i = 0; i < forces.size(); ++i)
+    {
+        forces.set(i, si::vec3{ si::newton{ 0.0f }, si::newton{ 0.0f }, si::newton{ static_cast<float>(i) } });
+        arms.set(i, si::vec3{ si::meter{ 2.0f }, si::meter{ 1.0f }, si::meter{ 1.0f } });
+    }
+
+    auto work = si::dot(forces, arms);
+    static_assert(std::same_as<decltype(work), si::quantity_vector<si::joule<float>>>);
+    REQUIRE(work.values()[36] == 36.0f);
+
+    auto torque = si::cross(arms, forces);
+    static_assert(std::same_as<decltype(torque), si::vec3_soa<si::joule<float>>>);
+    for (std::size_t i = 0; i < torque.size(); ++i)
+    {
+        const auto expected = si::cross(arms.get(i), forces.get(i));
+        REQUIRE(torque.get(i).x.value == expected.x.value);
+        REQUIRE(torque.get(i).y.value == expected.y.value);
+        REQUIRE(torque.get(i).z.value == expected.z.value);
+    }
+
+    auto scale = si::mat3<si::dimensionless<float>>::identity();
+    scale(0, 0).value = 3.0f;
+    auto scaled = scale * arms;
+    static_assert(std::same_as<decltype(scaled), si::vec3_soa<si::meter<float>>>);
+    REQUIRE(scaled.get(5).x.value == 6.0f);
+    REQUIRE(scaled.get(5).y.value == 1.0f);
+}
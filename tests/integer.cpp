@@ -0,0 +1,86 @@
+#include "si.h"
+#include "si_integer.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <limits>
+
+TEST_CASE("Integer rescaling is exact", "[Integer]") {
+    constexpr auto kilo_meters = si::kilo_meter<std::int32_t>{ 123456 };
+    constexpr auto meters = si::meter<std::int32_t>{ 0 } + kilo_meters;
+    static_assert(meters.value == 123456000);
+
+    constexpr auto back = si::kilo(si::meter<std::int32_t>{ 123456789 });
+    static_assert(back.value == 123456);
+
+    constexpr auto millis = si::milli(si::meter<std::int64_t>{ 7 });
+    static_assert(millis.value == 7000);
+
+    //Factor 1852/3600 (knot in meters per second) needs the wide intermediate
+    constexpr auto knots = si::details::integer_rescale<si::details::ratio{ 1852, 3600 }>(std::int32_t{ 1'000'000 });
+    static_assert(knots == 514444);
+
+    //Divisors beyond the range of the type leave nothing
+    static_assert(si::details::integer_rescale<si::details::ratio{ 1, 1000 }>(std::int8_t{ 100 }) == 0);
+}
+
+
+TEST_CASE("Saturating integers clamp", "[Integer]") {
+    using sat = si::saturating<std::int16_t>;
+    constexpr auto max = std::numeric_limits<std::int16_t>::max();
+    constexpr auto min = std::numeric_limits<std::int16_t>::min();
+
+    static_assert((sat{ max } + sat{ 1 }).value == max);
+    static_assert((sat{ min } - sat{ 1 }).value == min);
+    static_assert((sat{ 300 } * sat{ -300 }).value == min);
+    static_assert((sat{ min } / sat{ -1 }).value == max);
+    static_assert((si::saturating<std::uint8_t>{ 3 } - si::saturating<std::uint8_t>{ 5 }).value == 0);
+
+    constexpr auto meters = si::meter<sat>{ 0 } + si::kilo_meter<sat>{ 40 };
+    static_assert(meters.value.value == max);
+
+    constexpr auto negative = si::meter<sat>{ 0 } + si::kilo_meter<sat>{ -40 };
+    static_assert(negative.value.value == min);
+
+    constexpr auto fits = si::meter<sat>{ 0 } + si::kilo_meter<sat>{ 32 };
+    static_assert(fits.value.value == 32000);
+}
+
+
+TEST_CASE("Checked integers remember overflow", "[Integer]") {
+    using chk = si::checked<std::int32_t>;
+
+    auto sum = si::meter<chk>{ 1 } + si::meter<chk>{ 2 };
+    REQUIRE(sum.value.valid());
+    REQUIRE(sum.value == chk{ 3 });
+
+    auto scaled = si::meter<chk>{ 0 } + si::mega_meter<chk>{ 5000 };
+    REQUIRE_FALSE(scaled.value.valid());
+
+    //Once set the flag survives later operations that fit
+    auto later = scaled - si::meter<chk>{ 1 };
+    REQUIRE_FALSE(later.value.valid());
+
+    auto product = si::meter<chk>{ 1 << 16 } * si::meter<chk>{ 1 << 16 };
+    REQUIRE_FALSE(product.value.valid());
+}
+
+
+TEST_CASE("Fixed point quantities", "[Integer]") {
+    using q16 = si::fixed<std::int32_t, 16>;
+
+    constexpr auto distance = si::meter<q16>{ q16{ 1.5 } };
+    constexpr auto time = si::second<q16>{ q16{ 2 } };
+    constexpr auto speed = distance / time;
+
+    static_assert(std::same_as<std::remove_cvref_t<decltype(speed)>, si::meters_per_second<q16>>);
+    static_assert(speed.value == q16{ 0.75 });
+    static_assert(speed.value.as<double>() == 0.75);
+
+    constexpr auto meters = si::meter<q16>{ 0 } + si::kilo_meter<q16>{ q16{ 1.25 } };
+    static_assert(meters.value == q16{ 1250 });
+
+    constexpr auto kilo = si::kilo(si::meter<q16>{ q16{ 500 } });
+    static_assert(kilo.value == q16{ 0.5 });
+}
@@ -0,0 +1,164 @@
+#include "si_math.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <cmath>
+#include <vector>
+
+TEST_CASE("Powers compute exponents at compile time", "[Math]") {
+    auto area = si::pow<2>(si::meter{ 3.0 });
+    static_assert(std::same_as<decltype(area), si::SquareMeters<double>>);
+    REQUIRE(area.value == 9.0);
+
+    auto volume = si::pow<3>(si::meter{ 2.0 });
+    static_assert(std::same_as<decltype(volume), si::CubicMeters<double>>);
+    REQUIRE(volume.value == 8.0);
+
+    auto frequency = si::pow<-1>(si::second{ 0.5 });
+    static_assert(std::same_as<decltype(frequency), si::hertz<double>>);
+    REQUIRE(frequency.value == 2.0);
+
+    //Scales are raised exactly
+    auto km2 = si::pow<2>(si::kilo_meter{ 3.0 });
+    static_assert(decltype(km2)::Descriptor().factor == si::details::ratio{ 1, 1, 6 });
+    REQUIRE(km2.value == 9.0);
+
+    constexpr auto integer = si::pow<2>(si::meter{ 7 });
+    static_assert(integer.value == 49);
+}
+
+
+TEST_CASE("Roots give back the unit or fractional exponents", "[Math]") {
+    auto side = si::sqrt(si::SquareMeters{ 16.0 });
+    static_assert(std::same_as<decltype(side), si::meter<double>>);
+    REQUIRE(side.value == 4.0);
+
+    auto edge = si::cbrt(si::CubicMeters{ 27.0 });
+    static_assert(std::same_as<decltype(edge), si::meter<double>>);
+    REQUIRE(edge.value == Catch::Approx(3.0));
+
+    //A scale with an exact root stays, 1e6 m^2 has the root 1e3 m
+    auto km = si::sqrt(si::kilo_meter{ 2.0 } * si::kilo_meter{ 8.0 });
+    static_assert(std::same_as<decltype(km), si::kilo_meter<double>>);
+    REQUIRE(km.value == 4.0);
+
+    auto root = si::sqrt(si::meter{ 4.0f });
+    static_assert(decltype(root)::Descriptor().exponent[0] == si::details::rational{ 1, 2 });
+    static_assert(decltype(root)::Descriptor().factor == si::details::ratio{});
+    REQUIRE(root.value == 2.0f);
+    static_assert(std::same_as<decltype(root * root), si::meter<float>>);
+    static_assert(std::same_as<decltype(si::pow<2>(root)), si::meter<float>>);
+
+    //1000 has no exact square root, the value moves to coherent units first
+    auto coherent = si::sqrt(si::kilo_meter{ 4.0 });
+    static_assert(decltype(coherent)::Descriptor().factor == si::details::ratio{});
+    REQUIRE(coherent.value == Catch::Approx(std::sqrt(4000.0)));
+
+    //Noise density, V / Hz^1/2
+    auto density = si::volt{ 2e-9 } / si::sqrt(si::hertz{ 100.0 });
+    static_assert(decltype(density)::Descriptor().exponent[1] == si::details::rational{ -5, 2 });
+    REQUIRE(density.value == Catch::Approx(2e-10));
+}
+
+
+TEST_CASE("abs, hypot, fma and clamp", "[Math]") {
+    REQUIRE(si::abs(si::meter{ -2.5 }).value == 2.5);
+    REQUIRE(si::abs(si::second{ -3 }).value == 3);
+    static_assert(std::same_as<decltype(si::abs(si::meter{ -2.5 })), si::meter<double>>);
+
+    auto distance = si::hypot(si::meter{ 3.0 }, si::kilo_meter{ 0.004 });
+    static_assert(std::same_as<decltype(distance), si::meter<double>>);
+    REQUIRE(distance.value == Catch::Approx(5.0));
+    REQUIRE(si::hypot(si::meter{ 2.0 }, si::meter{ 3.0 }, si::meter{ 6.0 }).value == Catch::Approx(7.0));
+    REQUIRE(si::hypot(si::meter{ 3e200 }, si::meter{ 4e200 }).value == Catch::Approx(5e200));
+
+    auto energy = si::fma(si::newton{ 2.0 }, si::meter{ 3.0 }, si::joule{ 1.0 });
+    static_assert(std::same_as<decltype(energy), si::joule<double>>);
+    REQUIRE(energy.value == 7.0);
+    //newton * kilo_meter is in kilo joule, c is rescaled into it
+    REQUIRE(si::fma(si::newton{ 2.0 }, si::kilo_meter{ 3.0 }, si::joule{ 500.0 }).value == 6.5);
+
+    auto clamped = si::clamp(si::meter{ 5.0 }, si::meter{ 0.0 }, si::kilo_meter{ 0.002 });
+    static_assert(std::same_as<decltype(clamped), si::meter<double>>);
+    REQUIRE(clamped.value == 2.0);
+    REQUIRE(si::clamp(si::meter{ -1.0 }, si::meter{ 0.0 }, si::meter{ 3.0 }).value == 0.0);
+}
+
+
+TEST_CASE("Batch math matches the scalar functions", "[Math]") {
+    constexpr std::size_t n = 37;
+    auto area = si::quantity_vector<si::SquareMeters<float>>(n);
+    auto x = si::quantity_vector<si::meter<float>>(n);
+    auto y = si::quantity_vector<si::kilo_meter<float>>(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        area.values()[i] = 0.5f * static_cast<float>(i);
+        x.values()[i] = static_cast<float>(i) - 18.0f;
+        y.values()[i] = 0.001f * static_cast<float>(i % 5);
+    }
+
+    auto sides = si::sqrt(area);
+    static_assert(std::same_as<decltype(sides), si::quantity_vector<si::meter<float>>>);
+    auto lengths = si::hypot(x, y);
+    static_assert(std::same_as<decltype(lengths), si::quantity_vector<si::meter<float>>>);
+    auto squares = si::pow<2>(x);
+    auto magnitudes = si::abs(x);
+    auto limited = si::clamp(x, si::meter{ -5.0f }, si::meter{ 5.0f });
+    auto roots = si::cbrt(x);
+    auto moved = si::fma(x, x, area);
+    static_assert(std::same_as<decltype(moved), si::quantity_vector<si::SquareMeters<float>>>);
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const auto xi = si::meter{ x.values()[i] };
+        REQUIRE(sides.values()[i] == si::sqrt(si::SquareMeters{ area.values()[i] }).value);
+        REQUIRE(lengths.values()[i] == Catch::Approx(si::hypot(xi, si::kilo_meter{ y.values()[i] }).value));
+        REQUIRE(squares.values()[i] == si::pow<2>(xi).value);
+        REQUIRE(magnitudes.values()[i] == si::abs(xi).value);
+        REQUIRE(limited.values()[i] == si::clamp(xi, si::meter{ -5.0f }, si::meter{ 5.0f }).value);
+        REQUIRE(roots.values()[i] == Catch::Approx(si::cbrt(xi).value));
+        REQUIRE(moved.values()[i] == Catch::Approx(si::fma(xi, xi, si::SquareMeters{ area.values()[i] }).value));
+    }
+
+    //Inexact scale, rescaled before the root
+    auto coherent = si::sqrt(y);
+    for (std::size_t i = 0; i < n; ++i)
+        REQUIRE(coherent.values()[i] == Catch::Approx(si::sqrt(si::kilo_meter{ y.values()[i] }).value));
+
+    //In place on `x`, with `y` in another scale
+    si::hypot(x.span(), y.span(), x.span());
+    for (std::size_t i = 0; i < n; ++i)
+        REQUIRE(x.values()[i] == Catch::Approx(lengths.values()[i]));
+}
+
+
+TEST_CASE("SIMD sqrt and hypot agree on every instruction set", "[Math]") {
+    using si::details::simd::isa;
+
+    constexpr std::size_t n = 43;
+    auto x = std::vector<double>(n);
+    auto y = std::vector<double>(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        //Squares that are not exact, so a fused multiply add would round differently
+        x[i] = 0.1 * static_cast<double>(i) + 1.0 / 3.0;
+        y[i] = std::sqrt(static_cast<double>(i) + 2.0);
+    }
+
+    auto expected_sqrt = std::vector<double>(n);
+    auto expected_hypot = std::vector<double>(n);
+    si::details::simd::sqrt(x.data(), expected_sqrt.data(), n, isa::scalar);
+    si::details::simd::hypot(x.data(), y.data(), expected_hypot.data(), n, isa::scalar);
+
+    for (auto target : { isa::sse2, isa::avx2, isa::avx512 })
+    {
+        if (target > si::details::simd::active_isa())
+            continue;
+        auto out = std::vector<double>(n);
+        si::details::simd::sqrt(x.data(), out.data(), n, target);
+        REQUIRE(out == expected_sqrt);
+        si::details::simd::hypot(x.data(), y.data(), out.data(), n, target);
+        REQUIRE(out == expected_hypot);
+    }
+}
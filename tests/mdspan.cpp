@@ -0,0 +1,145 @@
+#include "si_mdspan.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <array>
+#include <cstddef>
+#include <set>
+#include <vector>
+
+namespace
+{
+#ifdef __cpp_lib_mdspan
+    using extents_3d = std::dextents<std::size_t, 3>;
+    using extents_2d = std::dextents<std::size_t, 2>;
+#else
+    //The parts of std::extents a layout mapping uses, for standard libraries without <mdspan>
+    template <std::size_t Rank>
+    struct test_extents
+    {
+        using index_type = std::size_t;
+        using rank_type = std::size_t;
+
+        std::array<std::size_t, Rank> sizes{};
+
+        static constexpr rank_type rank() { return Rank; }
+        constexpr index_type extent(rank_type r) const { return sizes[r]; }
+        friend constexpr bool operator==(const test_extents&, const test_extents&) = default;
+    };
+
+    using extents_3d = test_extents<3>;
+    using extents_2d = test_extents<2>;
+#endif
+}
+
+TEST_CASE("Accessor rescales lazily from the storage unit", "[Mdspan]") {
+    auto raw = std::vector<float>{ 1.5f, 2.0f, 0.25f };
+
+    //Same scale, the reference is the one of quantity_span
+    auto same = si::quantity_accessor<si::pascal<float>>{};
+    static_assert(std::same_as<decltype(same)::reference, si::details::quantity_reference<si::pascal<float>>>);
+    si::pascal<float> p = same.access(raw.data(), 1);
+    REQUIRE(p.value == 2.0f);
+
+    //Values written in kilo pascal, seen as pascal
+    using kilo_pascal = decltype(si::kilo(si::pascal{ 1.0f }));
+    auto scaled = si::quantity_accessor<si::pascal<float>, kilo_pascal>{};
+    si::pascal<float> read = scaled.access(raw.data(), 0);
+    REQUIRE(read.value == 1500.0f);
+    REQUIRE(raw[0] == 1.5f);
+
+    //Writes go back in the storage scale
+    scaled.access(raw.data(), 2) = si::pascal{ 750.0f };
+    REQUIRE(raw[2] == Catch::Approx(0.75f));
+    scaled.access(raw.data(), 1) = kilo_pascal{ 3.0f };
+    REQUIRE(raw[1] == 3.0f);
+    REQUIRE(static_cast<si::pascal<float>>(scaled.access(scaled.offset(raw.data(), 1), 0)).value == 3000.0f);
+
+    //Read only view of const storage
+    auto read_only = si::quantity_accessor<si::pascal<float>, const kilo_pascal>(scaled);
+    static_assert(std::same_as<decltype(read_only)::element_type, const si::pascal<float>>);
+    static_assert(!std::is_assignable_v<decltype(read_only)::reference, si::pascal<float>>);
+    static_assert(std::is_assignable_v<decltype(scaled)::reference, si::pascal<float>>);
+    const auto* constant = raw.data();
+    REQUIRE(static_cast<si::pascal<float>>(read_only.access(constant, 2)).value == Catch::Approx(750.0f));
+}
+
+
+TEST_CASE("Tiled layout maps every index once", "[Mdspan]") {
+    using layout = si::layout_tiled<2, 4, 4>;
+    auto extents = extents_3d{};
+#ifdef __cpp_lib_mdspan
+    extents = extents_3d{ 5, 8, 6 };
+#else
+    extents.sizes = { 5, 8, 6 };
+#endif
+    auto map = layout::mapping<extents_3d>(extents);
+
+    //Padded to 3 x 2 x 2 tiles of 32 elements
+    REQUIRE(map.required_span_size() == 3 * 2 * 2 * 32);
+    REQUIRE(!map.is_exhaustive());
+
+    auto seen = std::set<std::size_t>{};
+    for (std::size_t i = 0; i < 5; ++i)
+        for (std::size_t j = 0; j < 8; ++j)
+            for (std::size_t k = 0; k < 6; ++k)
+            {
+                const auto offset = map(i, j, k);
+                REQUIRE(offset < map.required_span_size());
+                seen.insert(offset);
+            }
+    REQUIRE(seen.size() == 5 * 8 * 6);
+
+    //Elements of a tile are contiguous, row major inside
+    REQUIRE(map(0, 0, 0) == 0);
+    REQUIRE(map(0, 0, 1) == 1);
+    REQUIRE(map(0, 1, 0) == 4);
+    REQUIRE(map(1, 3, 3) == 31);
+    REQUIRE(map(0, 0, 4) == 32);
+    REQUIRE(map(0, 4, 0) == 64);
+    REQUIRE(map(2, 0, 0) == 128);
+
+    auto exact = extents_2d{};
+#ifdef __cpp_lib_mdspan
+    exact = extents_2d{ 8, 8 };
+#else
+    exact.sizes = { 8, 8 };
+#endif
+    REQUIRE(si::layout_tiled<4, 4>::mapping<extents_2d>(exact).is_exhaustive());
+}
+
+
+TEST_CASE("Tiled temperature field viewed in another scale", "[Mdspan]") {
+    using layout = si::layout_tiled<4, 4>;
+    auto extents = extents_2d{};
+#ifdef __cpp_lib_mdspan
+    extents = extents_2d{ 6, 7 };
+#else
+    extents.sizes = { 6, 7 };
+#endif
+    const auto map = layout::mapping<extents_2d>(extents);
+
+    //A solver wrote milli kelvin in tiles
+    using milli_kelvin = decltype(si::milli(si::kelvin{ 1.0 }));
+    auto raw = std::vector<double>(map.required_span_size());
+    for (std::size_t i = 0; i < 6; ++i)
+        for (std::size_t j = 0; j < 7; ++j)
+            raw[map(i, j)] = 1000.0 * static_cast<double>(i * 10 + j);
+
+    const auto access = si::quantity_accessor<si::kelvin<double>, const milli_kelvin>{};
+    const auto* data = raw.data();
+    for (std::size_t i = 0; i < 6; ++i)
+        for (std::size_t j = 0; j < 7; ++j)
+            REQUIRE(static_cast<si::kelvin<double>>(access.access(data, map(i, j))).value == Catch::Approx(static_cast<double>(i * 10 + j)));
+
+#ifdef __cpp_lib_mdspan
+    auto field = si::quantity_mdspan<si::kelvin<double>, extents_2d, layout, const milli_kelvin>(data, map);
+    REQUIRE(static_cast<si::kelvin<double>>(field[5, 6]).value == Catch::Approx(56.0));
+
+    //The first tile alone is a strided 4 x 4 block
+    auto tile = si::quantity_mdspan<si::kelvin<double>, extents_2d, std::layout_stride, const milli_kelvin>(
+        data, std::layout_stride::mapping(extents_2d{ 4, 4 }, std::array<std::size_t, 2>{ 4, 1 }));
+    REQUIRE(static_cast<si::kelvin<double>>(tile[3, 2]).value == Catch::Approx(32.0));
+#endif
+}
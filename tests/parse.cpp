@@ -0,0 +1,126 @@
+#include "si_parse.h"
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("Parse formatter output", "[Parse]") {
+    using namespace std::string_view_literals;
+
+    auto text = "7.14 m A^-1"sv;
+    auto value = decltype(si::meter<double>{} / si::ampere<double>{}){};
+
+    auto [ptr, ec] = si::from_chars(text.data(), text.data() + text.size(), value);
+
+    REQUIRE(ec == std::errc{});
+    REQUIRE(ptr == text.data() + text.size());
+    REQUIRE(value.value == 7.14);
+}
+
+
+TEST_CASE("Parse without space and reordered units", "[Parse]") {
+    using namespace std::string_view_literals;
+
+    auto force = si::newton<float>{};
+
+    auto compact = "7.5m s^-2 kg"sv;
+    REQUIRE(si::from_chars(compact.data(), compact.data() + compact.size(), force).ec == std::errc{});
+    REQUIRE(force.value == 7.5f);
+
+    auto reordered = "2 kg m s^-1 s^-1"sv;
+    REQUIRE(si::from_chars(reordered.data(), reordered.data() + reordered.size(), force).ec == std::errc{});
+    REQUIRE(force.value == 2.0f);
+}
+
+
+TEST_CASE("Parse rejects dimension mismatch", "[Parse]") {
+    using namespace std::string_view_literals;
+
+    auto text = "25.2 s"sv;
+    auto length = si::meter<float>{ 1.0f };
+
+    auto [ptr, ec] = si::from_chars(text.data(), text.data() + text.size(), length);
+
+    REQUIRE(ec == std::errc::argument_out_of_domain);
+    REQUIRE(ptr == text.data());
+    REQUIRE(length.value == 1.0f);
+
+    auto unknown = "25.2 furlong"sv;
+    REQUIRE(si::from_chars(unknown.data(), unknown.data() + unknown.size(), length).ec == std::errc::invalid_argument);
+
+    //Starts with the text of the target unit
+    auto speed = "25 m s^-1"sv;
+    REQUIRE(si::from_chars(speed.data(), speed.data() + speed.size(), length).ec == std::errc::argument_out_of_domain);
+    REQUIRE(length.value == 1.0f);
+
+    auto ratio = si::unit<float, si::details::unit_descriptor{ .exponent = {}, .factor = 1 }>{};
+    auto meters = "5 m"sv;
+    REQUIRE(si::from_chars(meters.data(), meters.data() + meters.size(), ratio).ec == std::errc::argument_out_of_domain);
+    auto plain = "5"sv;
+    REQUIRE(si::from_chars(plain.data(), plain.data() + plain.size(), ratio).ec == std::errc{});
+    REQUIRE(ratio.value == 5.0f);
+}
+
+
+TEST_CASE("Parse fractional exponents", "[Parse]") {
+    using namespace std::string_view_literals;
+
+    //Noise density, V Hz^-1/2
+    using density = si::unit<double, si::details::unit_descriptor{ .exponent = { 2, { -5, 2 }, 0, -1, 0, 0, 1 }, .factor = 1 }>;
+    auto value = density{};
+
+    auto text = "4.5 m^2 s^-5/2 A^-1 kg"sv;
+    REQUIRE(si::from_chars(text.data(), text.data() + text.size(), value).ec == std::errc{});
+    REQUIRE(value.value == 4.5);
+
+    auto halves = "1.5 m^2 s^-1/2 s^-2/1 A^-1 kg"sv;
+    REQUIRE(si::from_chars(halves.data(), halves.data() + halves.size(), value).ec == std::errc{});
+    REQUIRE(value.value == 1.5);
+
+    auto zero = "1.5 m^1/0"sv;
+    REQUIRE(si::from_chars(zero.data(), zero.data() + zero.size(), value).ec == std::errc::invalid_argument);
+}
+
+
+TEST_CASE("Parse csv column", "[Parse]") {
+    using namespace std::string_view_literals;
+
+    auto csv = "time,distance\r\n0 s,1.5 m\r\n1 s,2.5 m\r\n\r\n2 s,3.5 m\r\n"sv;
+    auto distances = si::quantity_vector<si::meter<float>>{};
+
+    auto [ptr, ec] = si::parse_column(csv, 1, distances, ',', 1);
+
+    REQUIRE(ec == std::errc{});
+    REQUIRE(distances.size() == 3);
+    REQUIRE(distances.values()[2] == 3.5f);
+
+    auto bad = "1 m\n2 s\n"sv;
+    auto lengths = si::quantity_vector<si::meter<float>>{};
+    auto result = si::parse_column(bad, 0, lengths);
+
+    REQUIRE(result.ec == std::errc::argument_out_of_domain);
+    REQUIRE(result.ptr == bad.data() + 4);
+    REQUIRE(lengths.size() == 1);
+}
+
+
+TEST_CASE("Parse exponent form into a prefixed unit", "[Parse]") {
+    using namespace std::string_view_literals;
+
+    auto distance = si::kilo_meter<double>{};
+    auto meters = "1.5 m"sv;
+    REQUIRE(si::from_chars(meters.data(), meters.data() + meters.size(), distance).ec == std::errc{});
+    REQUIRE(distance.value == Catch::Approx(0.0015));
+
+    auto mass = si::kilo_gram<double>{};
+    auto grams = "2 g"sv;
+    REQUIRE(si::from_chars(grams.data(), grams.data() + grams.size(), mass).ec == std::errc{});
+    REQUIRE(mass.value == Catch::Approx(0.002));
+
+    auto duration = si::prefixed<si::prefix::milli, si::second<double>>{};
+    auto seconds = "3 s"sv;
+    auto kilo_seconds = "3 ks"sv;
+    REQUIRE(si::from_chars(seconds.data(), seconds.data() + seconds.size(), duration).ec == std::errc{});
+    REQUIRE(duration.value == 3000.0);
+    REQUIRE(si::from_chars(kilo_seconds.data(), kilo_seconds.data() + kilo_seconds.size(), duration).ec == std::errc{});
+    REQUIRE(duration.value == 3000000.0);
+}
@@ -0,0 +1,152 @@
+#include "si_dynamic.h"
+#include "si_parse.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <format>
+#include <string>
+#include <string_view>
+
+TEST_CASE("Prefix functions infer prefixed named units", "[Prefix]") {
+    using nano_second = si::prefixed<si::prefix::nano, si::second<double>>;
+    using giga_watt = si::prefixed<si::prefix::giga, si::watt<double>>;
+
+    static_assert(std::same_as<decltype(si::nano(si::second{ 1.0 })), nano_second>);
+    static_assert(std::same_as<decltype(si::giga(si::watt{ 1.0 })), giga_watt>);
+    static_assert(std::same_as<decltype(si::micro(si::gram{ 1.0f })), si::prefixed<si::prefix::micro, si::gram<float>>>);
+
+    //Registered types win over the generated ones
+    static_assert(std::same_as<decltype(si::kilo(si::meter{ 1.0 })), si::kilo_meter<double>>);
+    static_assert(std::same_as<decltype(si::kilo(si::gram{ 1.0 })), si::kilo_gram<double>>);
+    static_assert(std::same_as<decltype(si::mega(si::gram{ 1.0 })), si::ton<double>>);
+
+    //Scales that are not a prefix of a named unit stay plain units
+    static_assert(std::same_as<decltype(si::kilo(si::meters_per_second{ 1.0 })), si::unit<double, si::details::velocity_desc * 1000>>);
+    static_assert(std::same_as<decltype(si::kilo(si::minute{ 1.0 })), si::unit<double, si::details::second_desc * 60000>>);
+
+    //The value is converted, 1.5 s are 1.5e9 ns
+    REQUIRE(si::nano(si::second{ 1.5 }).value == Catch::Approx(1.5e9));
+    REQUIRE(si::quetta(si::meter{ 3e30 }).value == Catch::Approx(3.0));
+    REQUIRE(si::deca(si::ampere{ 20 }).value == 2);
+    REQUIRE(si::centi(si::kelvin{ 2 }).value == 200);
+}
+
+
+TEST_CASE("Arithmetic between prefixes folds at compile time", "[Prefix]") {
+    using micro_second = si::prefixed<si::prefix::micro, si::second<double>>;
+    using milli_second = si::prefixed<si::prefix::milli, si::second<double>>;
+
+    //One constant factor between any two prefixes
+    static_assert(si::details::conversion_factor(micro_second::Descriptor(), milli_second::Descriptor()) == si::details::ratio{ 1, 1000 });
+    static_assert((milli_second{ 2.0 } + micro_second{ 500.0 }).value == 2.5);
+    static_assert((micro_second{ 500.0 } + milli_second{ 2.0 }).value == 2500.0);
+
+    //Integers stay exact
+    using nano_second = si::prefixed<si::prefix::nano, si::second<std::int64_t>>;
+    using kilo_second = si::kilo_second<std::int64_t>;
+    static_assert((nano_second{ 7 } + kilo_second{ 3 }).value == 3'000'000'000'007);
+
+    //Products land on prefixed units, kV * A is a kW
+    using kilo_volt = si::prefixed<si::prefix::kilo, si::volt<double>>;
+    constexpr auto power = kilo_volt{ 11.0 } * si::ampere{ 200.0 };
+    static_assert(std::same_as<std::remove_const_t<decltype(power)>, si::prefixed<si::prefix::kilo, si::watt<double>>>);
+    static_assert(power.value == 2200.0);
+    REQUIRE((si::watt<double>{ 0.0 } + power).value == 2.2e6);
+}
+
+
+TEST_CASE("Prefixed symbols are written and read", "[Prefix]") {
+    using namespace std::string_view_literals;
+
+    static_assert(si::details::unit_suffix<si::kilo_meter<float>::Descriptor()>.view() == " km");
+    static_assert(si::details::unit_suffix<si::kilo_gram<float>::Descriptor()>.view() == " kg");
+    static_assert(si::details::unit_suffix<si::prefixed<si::prefix::micro, si::second<float>>::Descriptor()>.view() == " µs");
+    static_assert(si::details::unit_suffix<si::prefixed<si::prefix::giga, si::watt<float>>::Descriptor()>.view() == " GW");
+    static_assert(si::details::unit_suffix<si::prefixed<si::prefix::deca, si::meter<float>>::Descriptor()>.view() == " dam");
+    static_assert(si::details::unit_suffix<si::prefixed<si::prefix::milli, si::ohm<float>>::Descriptor()>.view() == " mΩ");
+    //Coherent and other scaled units keep the exponent form
+    static_assert(si::details::unit_suffix<si::gram<float>::Descriptor()>.view() == " g");
+    static_assert(si::details::unit_suffix<si::watt<float>::Descriptor()>.view() == " m^2 s^-3 kg");
+    static_assert(si::details::unit_suffix<si::minute<float>::Descriptor()>.view() == " s");
+
+    //The formatter's own text
+    auto latency = si::prefixed<si::prefix::nano, si::second<double>>{};
+    auto text = "250 ns"sv;
+    auto [ptr, ec] = si::from_chars(text.data(), text.data() + text.size(), latency);
+    REQUIRE(ec == std::errc{});
+    REQUIRE(ptr == text.data() + text.size());
+    REQUIRE(latency.value == 250.0);
+
+    //Other prefixes and derived names are rescaled
+    auto seconds = si::second<double>{};
+    for (auto [input, expected] : { std::pair{ "250 ns"sv, 250e-9 }, { "1.5 µs"sv, 1.5e-6 }, { "1.5 us"sv, 1.5e-6 }, { "3 ks"sv, 3000.0 }, { "4 s"sv, 4.0 } })
+    {
+        REQUIRE(si::from_chars(input.data(), input.data() + input.size(), seconds).ec == std::errc{});
+        REQUIRE(seconds.value == Catch::Approx(expected));
+    }
+
+    auto grid = si::prefixed<si::prefix::giga, si::watt<double>>{};
+    auto plant = "850 MW"sv;
+    REQUIRE(si::from_chars(plant.data(), plant.data() + plant.size(), grid).ec == std::errc{});
+    REQUIRE(grid.value == Catch::Approx(0.85));
+
+    auto pressure = si::pascal<double>{};
+    auto weather = "1013.25 hPa"sv;
+    REQUIRE(si::from_chars(weather.data(), weather.data() + weather.size(), pressure).ec == std::errc{});
+    REQUIRE(pressure.value == Catch::Approx(101325.0));
+
+    //Prefixed base symbols in the exponent form carry their scale too, kg m s^-2 is a newton
+    auto force = si::newton<double>{};
+    auto compound = "3 kN"sv;
+    REQUIRE(si::from_chars(compound.data(), compound.data() + compound.size(), force).ec == std::errc{});
+    REQUIRE(force.value == Catch::Approx(3000.0));
+    auto expanded = "3 kg m s^-2"sv;
+    REQUIRE(si::from_chars(expanded.data(), expanded.data() + expanded.size(), force).ec == std::errc{});
+    REQUIRE(force.value == Catch::Approx(3.0));
+    auto area = "2 km^2"sv;
+    auto field = si::SquareMeters<double>{};
+    REQUIRE(si::from_chars(area.data(), area.data() + area.size(), field).ec == std::errc{});
+    REQUIRE(field.value == Catch::Approx(2e6));
+
+    auto mismatch = "3 kPa"sv;
+    REQUIRE(si::from_chars(mismatch.data(), mismatch.data() + mismatch.size(), force).ec == std::errc::argument_out_of_domain);
+    auto root = "3 km^1/2"sv;
+    auto odd = si::unit<double, si::details::unit_descriptor{ .exponent = { si::details::rational{ 1, 2 }, 0, 0, 0, 0, 0, 0 }, .factor = 1 }>{};
+    REQUIRE(si::from_chars(root.data(), root.data() + root.size(), odd).ec == std::errc::invalid_argument);
+}
+
+
+TEST_CASE("Columns in a prefixed unit", "[Prefix]") {
+    using namespace std::string_view_literals;
+
+    auto csv = "latency\n250 ns\n1.5 µs\n300 ns\n"sv;
+    auto latencies = si::quantity_vector<si::prefixed<si::prefix::micro, si::second<double>>>{};
+    REQUIRE(si::parse_column(csv, 0, latencies, ',', 1).ec == std::errc{});
+    REQUIRE(latencies.size() == 3);
+    REQUIRE(latencies.values()[0] == Catch::Approx(0.25));
+    REQUIRE(latencies.values()[1] == Catch::Approx(1.5));
+    REQUIRE(latencies.values()[2] == Catch::Approx(0.3));
+}
+
+
+TEST_CASE("Coherent exponent form reads back in any scale", "[Prefix]") {
+    const auto round_trip = [](auto quantity) {
+        using U = decltype(quantity);
+        using kilo_unit = si::prefixed<si::prefix::kilo, U>;
+        const auto text = std::format("{}", quantity);
+
+        auto scaled = kilo_unit{};
+        REQUIRE(si::from_chars(text.data(), text.data() + text.size(), scaled).ec == std::errc{});
+        REQUIRE(scaled.value == Catch::Approx(quantity.value / 1000));
+
+        auto dynamic = si::dynamic_quantity<double>{};
+        REQUIRE(si::from_chars(text.data(), text.data() + text.size(), dynamic).ec == std::errc{});
+        REQUIRE(dynamic.as<U>()->value == Catch::Approx(quantity.value));
+    };
+
+    REQUIRE(std::format("{}", si::newton{ 7.5 }) == "7.5 m s^-2 kg");
+    round_trip(si::newton{ 7.5 });
+    round_trip(si::joule{ 12.0 });
+    round_trip(si::watt{ 250.0 });
+}
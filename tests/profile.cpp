@@ -0,0 +1,88 @@
+#ifndef SI_PROFILE_CONVERSIONS
+#define SI_PROFILE_CONVERSIONS
+#endif
+#include "si.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    std::uint64_t count_of(si::conversion_site site, si::details::ratio from, si::details::ratio to)
+    {
+        auto report = si::conversion_report();
+        auto found = std::find_if(report.begin(), report.end(), [&](const si::conversion_count& c) {
+            return c.site == site && c.from.factor == from && c.to.factor == to;
+        });
+        return found == report.end() ? 0 : found->count;
+    }
+
+    si::meter<double> add_kilometers(si::meter<double> total, si::kilo_meter<double> step)
+    {
+        return total + step;
+    }
+}
+
+TEST_CASE("Conversions are counted per site and pair", "[Profile]") {
+    si::reset_conversion_counts();
+
+    auto total = si::meter{ 0.0 };
+    for (int i = 0; i < 10; ++i)
+        total = add_kilometers(total, si::kilo_meter{ 1.0 });
+    REQUIRE(total.value == 10000.0);
+    REQUIRE(count_of(si::conversion_site::add, { 1, 1, 3 }, {}) == 10);
+
+    //Same scale operations are free and not counted
+    total = total + si::meter{ 1.0 };
+    total = total - si::meter{ 1.0 };
+    REQUIRE(count_of(si::conversion_site::add, {}, {}) == 0);
+
+    auto back = si::meter{ 0.0 };
+    back = back - si::milli(si::meter{ 5.0 });
+    REQUIRE(count_of(si::conversion_site::subtract, { 1, 1, -3 }, {}) == 1);
+
+    auto km = si::kilo(si::meter{ 2000.0 });
+    REQUIRE(km.value == 2.0);
+    REQUIRE(count_of(si::conversion_site::prefix, {}, { 1, 1, 3 }) == 1);
+
+    auto area = si::kilo_meter{ 1.0 } * si::meter{ 2.0 };
+    REQUIRE(area.value == 2.0);
+    REQUIRE(count_of(si::conversion_site::scaled_result, {}, { 1, 1, 3 }) >= 1);
+
+    //Constant evaluation is never counted
+    constexpr auto folded = si::meter{ 1.0 } + si::kilo_meter{ 1.0 };
+    static_assert(folded.value == 1001.0);
+    REQUIRE(count_of(si::conversion_site::add, { 1, 1, 3 }, {}) == 10);
+
+    si::reset_conversion_counts();
+    REQUIRE(count_of(si::conversion_site::add, { 1, 1, 3 }, {}) == 0);
+
+    //Counting goes on from the reset
+    total = add_kilometers(total, si::kilo_meter{ 1.0 });
+    REQUIRE(count_of(si::conversion_site::add, { 1, 1, 3 }, {}) == 1);
+}
+
+
+TEST_CASE("Counts of all threads are reported", "[Profile]") {
+    si::reset_conversion_counts();
+
+    auto worker = [] {
+        auto total = si::meter{ 0.0 };
+        for (int i = 0; i < 1000; ++i)
+            total = add_kilometers(total, si::kilo_meter{ 1.0 });
+        return total;
+    };
+
+    auto threads = std::vector<std::thread>{};
+    for (int i = 0; i < 4; ++i)
+        threads.emplace_back(worker);
+    for (auto& t : threads)
+        t.join();
+    (void)worker();
+
+    REQUIRE(count_of(si::conversion_site::add, { 1, 1, 3 }, {}) == 5000);
+    REQUIRE(si::dropped_conversions() == 0);
+}
@@ -0,0 +1,152 @@
+#include "si_queue.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <cstddef>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Single producer queue in one thread", "[Queue]") {
+    auto queue = si::spsc_queue<si::meter<double>>(6);
+    REQUIRE(queue.capacity() == 8);
+    REQUIRE(!queue.try_pop());
+
+    //Kilo meter is converted on the way in
+    using kilo_meter = decltype(si::kilo(si::meter{ 1.0 }));
+    REQUIRE(queue.try_push(si::meter{ 2.0 }));
+    REQUIRE(queue.try_push(kilo_meter{ 1.5 }));
+    REQUIRE(queue.size() == 2);
+    REQUIRE(queue.try_pop()->value == 2.0);
+    REQUIRE(queue.try_pop()->value == 1500.0);
+    REQUIRE(queue.size() == 0);
+
+    //Batches wrap around the end of the ring
+    auto in = si::quantity_vector<kilo_meter>(10);
+    for (std::size_t i = 0; i < in.size(); ++i)
+        in[i] = kilo_meter{ static_cast<double>(i) };
+    REQUIRE(queue.push(in.span()) == 8);
+    REQUIRE(!queue.try_push(si::meter{ 1.0 }));
+
+    auto out = si::quantity_vector<si::meter<double>>(5);
+    REQUIRE(queue.pop(out.span()) == 5);
+    for (std::size_t i = 0; i < 5; ++i)
+        REQUIRE(out.values()[i] == 1000.0 * static_cast<double>(i));
+    REQUIRE(queue.push(in.span().subspan(8)) == 2);
+
+    //The values at the head are contiguous up to the end of the ring
+    const auto region = queue.readable();
+    REQUIRE(region.size() == 1);
+    REQUIRE(region.data()[0] == 5000.0);
+    queue.consume(region.size());
+    REQUIRE(queue.readable().size() == 4);
+    REQUIRE(queue.pop(out.span()) == 4);
+    REQUIRE(out.values()[0] == 6000.0);
+    REQUIRE(out.values()[3] == 9000.0);
+}
+
+
+TEST_CASE("Producer fills the ring in place", "[Queue]") {
+    auto queue = si::spsc_queue<si::second<float>>(16);
+    auto slots = queue.writable();
+    REQUIRE(slots.size() == 16);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(slots.data()) % si::details::simd_alignment == 0);
+    for (std::size_t i = 0; i < 4; ++i)
+        slots[i] = si::second{ 0.5f * static_cast<float>(i) };
+    queue.commit(4);
+
+    const auto region = queue.readable();
+    REQUIRE(region.size() == 4);
+    REQUIRE(region.data() == slots.data());
+    REQUIRE(si::second<float>(region[3]).value == 1.5f);
+}
+
+
+TEST_CASE("Single producer stream between threads", "[Queue]") {
+    constexpr std::size_t total = 200000;
+    auto queue = si::spsc_queue<si::meter<double>>(1024);
+
+    auto producer = std::thread([&] {
+        using kilo_meter = decltype(si::kilo(si::meter{ 1.0 }));
+        auto batch = si::quantity_vector<kilo_meter>(37);
+        std::size_t next = 0;
+        while (next < total)
+        {
+            const auto n = std::min(batch.size(), total - next);
+            for (std::size_t i = 0; i < n; ++i)
+                batch[i] = kilo_meter{ static_cast<double>(next + i) };
+            auto pending = batch.span().subspan(0, n);
+            while (!pending.empty())
+                pending = pending.subspan(queue.push(pending));
+            next += n;
+        }
+    });
+
+    //Consumed in place, the values arrive in order
+    std::size_t expected = 0;
+    while (expected < total)
+    {
+        const auto region = queue.readable();
+        for (std::size_t i = 0; i < region.size(); ++i)
+            REQUIRE(region.data()[i] == 1000.0 * static_cast<double>(expected + i));
+        expected += region.size();
+        queue.consume(region.size());
+    }
+    producer.join();
+    REQUIRE(queue.size() == 0);
+}
+
+
+TEST_CASE("Multiple producers into one consumer", "[Queue]") {
+    constexpr std::size_t producers = 4;
+    constexpr std::size_t per_producer = 50000;
+    using kilo_gram = decltype(si::kilo(si::gram{ std::int64_t{ 1 } }));
+    auto queue = si::mpsc_queue<si::gram<std::int64_t>>(256);
+    REQUIRE(queue.capacity() == 256);
+
+    auto threads = std::vector<std::thread>{};
+    for (std::size_t p = 0; p < producers; ++p)
+        threads.emplace_back([&, p] {
+            //Odd producers push kilo gram one at a time, even ones batches of gram
+            if (p % 2 == 1)
+            {
+                for (std::size_t i = 0; i < per_producer; ++i)
+                    while (!queue.try_push(kilo_gram{ 1 }))
+                        std::this_thread::yield();
+                return;
+            }
+            auto batch = si::quantity_vector<si::gram<std::int64_t>>(50, si::gram{ std::int64_t{ 2 } });
+            for (std::size_t sent = 0; sent < per_producer; sent += batch.size())
+            {
+                auto pending = batch.span();
+                while (!pending.empty())
+                    pending = pending.subspan(queue.push(pending));
+            }
+        });
+
+    auto out = si::quantity_vector<si::gram<std::int64_t>>(64);
+    std::size_t received = 0;
+    std::int64_t sum = 0;
+    while (received < producers * per_producer)
+    {
+        const auto n = queue.pop(out.span());
+        sum = std::accumulate(out.values().begin(), out.values().begin() + static_cast<std::ptrdiff_t>(n), sum);
+        received += n;
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    REQUIRE(received == producers * per_producer);
+    REQUIRE(sum == 2 * static_cast<std::int64_t>(per_producer) * (1000 + 2));
+    REQUIRE(!queue.try_pop());
+
+    //A claim is invisible to the consumer until it is published
+    const auto slots = queue.try_claim(3);
+    REQUIRE(slots.size() == 3);
+    slots.span()[0] = si::gram{ std::int64_t{ 7 } };
+    REQUIRE(queue.readable().empty());
+    queue.publish(slots);
+    REQUIRE(queue.readable().size() == 3);
+    REQUIRE(queue.try_pop()->value == 7);
+}
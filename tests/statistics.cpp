@@ -0,0 +1,111 @@
+#include "si_statistics.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+TEST_CASE("Running mean and variance", "[Statistics]") {
+    auto stats = si::running_stats<si::second<double>>{};
+    for (auto x : { 2.0, 4.0, 4.0, 4.0, 5.0, 5.0, 7.0, 9.0 })
+        stats.add(si::second{ x });
+
+    REQUIRE(stats.count() == 8);
+    REQUIRE(stats.mean().value == 5.0);
+    REQUIRE(stats.stddev().value == 2.0);
+    REQUIRE(stats.min().value == 2.0);
+    REQUIRE(stats.max().value == 9.0);
+
+    auto variance = stats.variance();
+    static_assert(std::same_as<decltype(variance), decltype(si::second{ 1.0 } * si::second{ 1.0 })>);
+    REQUIRE(variance.value == 4.0);
+    REQUIRE(stats.sample_variance().value == Catch::Approx(32.0 / 7.0));
+
+    //Other scales are converted on the way in
+    stats.add(si::kilo_second{ 0.005 });
+    REQUIRE(stats.max().value == 9.0);
+    REQUIRE(stats.count() == 9);
+}
+
+
+TEST_CASE("Merged running stats match a single stream", "[Statistics]") {
+    auto all = si::running_stats<si::watt<double>>{};
+    auto left = si::running_stats<si::watt<double>>{};
+    auto right = si::running_stats<si::watt<double>>{};
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        const auto power = si::watt{ 100.0 + (i % 37) * 1.5 };
+        all.add(power);
+        (i < 300 ? left : right).add(power);
+    }
+    left.merge(right);
+
+    REQUIRE(left.count() == all.count());
+    REQUIRE(left.mean().value == Catch::Approx(all.mean().value));
+    REQUIRE(left.variance().value == Catch::Approx(all.variance().value));
+    REQUIRE(left.min().value == all.min().value);
+    REQUIRE(left.max().value == all.max().value);
+}
+
+
+TEST_CASE("Histogram with unit edges", "[Statistics]") {
+    auto latency = si::histogram<si::second<float>>(si::second{ 0.0f }, si::second{ 1.0f }, 10);
+    latency.add(si::second{ 0.05f });
+    latency.add(si::second{ 0.95f });
+    latency.add(si::kilo_second{ 0.00051f });
+    latency.add(si::second{ -1.0f });
+    latency.add(si::second{ 1.0f });
+
+    REQUIRE(latency.count(0) == 1);
+    REQUIRE(latency.count(5) == 1);
+    REQUIRE(latency.count(9) == 1);
+    REQUIRE(latency.underflow() == 1);
+    REQUIRE(latency.overflow() == 1);
+    REQUIRE(latency.edge(3).value == Catch::Approx(0.3f));
+
+    auto other = si::histogram<si::second<float>>(si::second{ 0.0f }, si::second{ 1.0f }, 10);
+    other.add(si::second{ 0.06f }, 4);
+    latency.merge(other);
+    REQUIRE(latency.count(0) == 5);
+
+    latency.add(si::second{ std::numeric_limits<float>::quiet_NaN() });
+    REQUIRE(latency.nan_count() == 1);
+    REQUIRE(latency.underflow() == 1);
+    REQUIRE(latency.overflow() == 1);
+}
+
+
+TEST_CASE("Quantile sketch", "[Statistics]") {
+    constexpr int n = 100000;
+    auto samples = std::vector<double>(n);
+    for (int i = 0; i < n; ++i)
+        samples[i] = static_cast<double>(i) / n;
+    std::shuffle(samples.begin(), samples.end(), std::mt19937{ 42 });
+
+    auto first = si::quantile_sketch<si::second<double>>{};
+    auto second = si::quantile_sketch<si::second<double>>{};
+    for (int i = 0; i < n; ++i)
+        (i % 2 ? first : second).add(si::second{ samples[i] });
+
+    first.merge(second);
+    REQUIRE(first.count() == n);
+    REQUIRE(first.centroids() <= 200);
+
+    REQUIRE(first.quantile(0.0).value == 0.0);
+    REQUIRE(first.quantile(1.0).value == Catch::Approx(0.99999));
+    REQUIRE(first.quantile(0.5).value == Catch::Approx(0.5).margin(0.005));
+    REQUIRE(first.quantile(0.99).value == Catch::Approx(0.99).margin(0.001));
+    REQUIRE(first.quantile(0.999).value == Catch::Approx(0.999).margin(0.0002));
+
+    //Merging with itself doubles every weight and keeps the distribution
+    first.merge(first);
+    REQUIRE(first.count() == 2 * n);
+    REQUIRE(first.centroids() <= 200);
+    REQUIRE(first.quantile(0.0).value == 0.0);
+    REQUIRE(first.quantile(0.5).value == Catch::Approx(0.5).margin(0.005));
+    REQUIRE(first.quantile(0.99).value == Catch::Approx(0.99).margin(0.001));
+}
@@ -0,0 +1,135 @@
+#include "si_table.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <cmath>
+#include <vector>
+
+TEST_CASE("Linear table through samples", "[Table]") {
+    //Samples in kilo pascal over kelvin, the table stores pascal
+    using kilo_pascal = decltype(si::kilo(si::pascal{ 1.0 }));
+    auto t = si::quantity_vector<si::kelvin<double>>{ si::kelvin{ 300.0 }, si::kelvin{ 310.0 }, si::kelvin{ 330.0 }, si::kelvin{ 360.0 } };
+    auto p = si::quantity_vector<kilo_pascal>{ kilo_pascal{ 3.5 }, kilo_pascal{ 6.2 }, kilo_pascal{ 17.2 }, kilo_pascal{ 62.0 } };
+
+    auto curve = si::lookup_table<si::kelvin<double>, si::pascal<double>>(t, p);
+    REQUIRE(curve.size() == 4);
+    REQUIRE(!curve.uniform());
+
+    static_assert(std::same_as<decltype(curve(si::kelvin{ 305.0 })), si::pascal<double>>);
+    REQUIRE(curve(si::kelvin{ 300.0 }).value == Catch::Approx(3500.0));
+    REQUIRE(curve(si::kelvin{ 305.0 }).value == Catch::Approx(4850.0));
+    REQUIRE(curve(si::kelvin{ 320.0 }).value == Catch::Approx(11700.0));
+    REQUIRE(curve(si::kelvin{ 360.0 }).value == Catch::Approx(62000.0));
+
+    //Outside the samples the ends are held
+    REQUIRE(curve(si::kelvin{ 250.0 }).value == Catch::Approx(3500.0));
+    REQUIRE(curve(si::kelvin{ 400.0 }).value == Catch::Approx(62000.0));
+
+    //Inputs in another scale are rescaled on lookup
+    REQUIRE(curve(si::milli(si::kelvin{ 345.0 })).value == Catch::Approx(curve(si::kelvin{ 345.0 }).value));
+}
+
+
+TEST_CASE("Cubic table is exact for quadratics", "[Table]") {
+    const auto positions = std::vector<double>{ 0.0, 0.3, 0.5, 1.1, 1.2, 2.0, 3.5 };
+    auto x = si::quantity_vector<si::second<double>>(positions.size());
+    auto y = si::quantity_vector<si::meter<double>>(positions.size());
+    for (std::size_t i = 0; i < positions.size(); ++i)
+    {
+        x[i] = si::second{ positions[i] };
+        y[i] = si::meter{ 2 * positions[i] * positions[i] - positions[i] + 1 };
+    }
+
+    auto cubic = si::lookup_table<si::second<double>, si::meter<double>, si::interpolation::cubic_t>(x, y, si::interpolation::cubic);
+    auto linear = si::lookup_table<si::second<double>, si::meter<double>>(x, y);
+    for (double s = 0.0; s <= 3.5; s += 0.05)
+    {
+        const auto expected = 2 * s * s - s + 1;
+        REQUIRE(cubic(si::second{ s }).value == Catch::Approx(expected).margin(1e-12));
+        REQUIRE(std::abs(linear(si::second{ s }).value - expected) <= 1.2);
+    }
+}
+
+
+TEST_CASE("Uniform grids and batches", "[Table]") {
+    constexpr std::size_t samples = 65;
+    auto y = si::quantity_vector<si::watt<float>>(samples);
+    auto x = si::quantity_vector<si::second<float>>(samples);
+    for (std::size_t i = 0; i < samples; ++i)
+    {
+        x[i] = si::second{ 0.25f * static_cast<float>(i) };
+        y[i] = si::watt{ std::sin(0.25f * static_cast<float>(i)) };
+    }
+
+    //A start and a step, or detected from the samples
+    auto from_step = si::lookup_table<si::second<float>, si::watt<float>, si::interpolation::cubic_t>(si::second{ 0.0f }, si::milli(si::second{ 0.25f }), y);
+    auto detected = si::lookup_table<si::second<float>, si::watt<float>, si::interpolation::cubic_t>(x, y);
+    REQUIRE(from_step.uniform());
+    REQUIRE(detected.uniform());
+    REQUIRE(from_step.back().value == 16.0f);
+
+    constexpr std::size_t n = 1001;
+    auto in = si::quantity_vector<si::second<float>>(n);
+    for (std::size_t i = 0; i < n; ++i)
+        in[i] = si::second{ 0.017f * static_cast<float>(i) - 0.5f };
+
+    auto batch = from_step(in);
+    static_assert(std::same_as<decltype(batch), si::quantity_vector<si::watt<float>>>);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const auto s = si::second{ in.values()[i] };
+        REQUIRE(batch.values()[i] == from_step(s).value);
+        REQUIRE(batch.values()[i] == Catch::Approx(detected(s).value).margin(1e-6));
+        REQUIRE(batch.values()[i] == Catch::Approx(std::sin(std::clamp(s.value, 0.0f, 16.0f))).margin(2e-3));
+    }
+
+    //Non uniform batches use the branchless search
+    x[1] = si::second{ 0.2f };
+    auto shifted = si::lookup_table<si::second<float>, si::watt<float>>(x, y);
+    REQUIRE(!shifted.uniform());
+    auto searched = shifted(in);
+    for (std::size_t i = 0; i < n; ++i)
+        REQUIRE(searched.values()[i] == shifted(si::second{ in.values()[i] }).value);
+}
+
+
+TEST_CASE("Bilinear table over two inputs", "[Table]") {
+    //Density of an ideal gas, p / (R T), in kilo gram per cubic meter
+    auto p = si::quantity_vector<si::pascal<double>>(5);
+    auto t = si::quantity_vector<si::kelvin<double>>{ si::kelvin{ 250.0 }, si::kelvin{ 300.0 }, si::kelvin{ 320.0 }, si::kelvin{ 400.0 } };
+    using density = decltype(si::kilo(si::gram{ 1.0 }) / si::CubicMeters{ 1.0 });
+    auto rho = si::quantity_vector<density>(5 * 4);
+    for (std::size_t i = 0; i < 5; ++i)
+    {
+        p[i] = si::pascal{ 1e5 * static_cast<double>(i + 1) };
+        for (std::size_t j = 0; j < 4; ++j)
+            rho[i * 4 + j] = density{ p.values()[i] / (287.0 * t.values()[j]) };
+    }
+
+    auto table = si::lookup_table_2d<si::pascal<double>, si::kelvin<double>, density>(p, t, rho);
+    REQUIRE(table.rows() == 5);
+    REQUIRE(table.columns() == 4);
+
+    //Exact at the samples, linear in pressure
+    REQUIRE(table(si::pascal{ 2e5 }, si::kelvin{ 300.0 }).value == Catch::Approx(2e5 / (287.0 * 300.0)));
+    REQUIRE(table(si::pascal{ 2.5e5 }, si::kelvin{ 320.0 }).value == Catch::Approx(2.5e5 / (287.0 * 320.0)));
+    REQUIRE(table(si::kilo(si::pascal{ 250000.0 }), si::kelvin{ 320.0 }).value == Catch::Approx(2.5e5 / (287.0 * 320.0)));
+
+    const auto mid = table(si::pascal{ 1.5e5 }, si::kelvin{ 275.0 }).value;
+    const auto corners = (1e5 / 250.0 + 1e5 / 300.0 + 2e5 / 250.0 + 2e5 / 300.0) / (4 * 287.0);
+    REQUIRE(mid == Catch::Approx(corners));
+
+    constexpr std::size_t n = 50;
+    auto a = si::quantity_vector<si::pascal<double>>(n);
+    auto b = si::quantity_vector<si::kelvin<double>>(n);
+    auto out = si::quantity_vector<density>(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        a[i] = si::pascal{ 2e4 * static_cast<double>(i) };
+        b[i] = si::kelvin{ 240.0 + 3.5 * static_cast<double>(i) };
+    }
+    table(a.span(), b.span(), out.span());
+    for (std::size_t i = 0; i < n; ++i)
+        REQUIRE(out.values()[i] == table(si::pascal{ a.values()[i] }, si::kelvin{ b.values()[i] }).value);
+}